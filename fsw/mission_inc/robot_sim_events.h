@@ -24,6 +24,7 @@
 **  Define Robot Sim Events IDs
 **
 ** Notes:
+**  Mission-wide: the table image budgets events by these IDs.
 **
 *************************************************************************/
 #ifndef _robot_sim_events_h_
@@ -37,8 +38,17 @@
 #define ROBOT_SIM_INVALID_MSGID_ERR_EID 5
 #define ROBOT_SIM_LEN_ERR_EID           6
 #define ROBOT_SIM_PIPE_ERR_EID          7
+#define ROBOT_SIM_COMMANDCTL_INF_EID    8
+#define ROBOT_SIM_CTRL_QUEUE_ERR_EID    9
+#define ROBOT_SIM_SENSOR_INF_EID        10
+#define ROBOT_SIM_REC_INF_EID           11
+#define ROBOT_SIM_REC_ERR_EID           12
+#define ROBOT_SIM_TBL_INF_EID           13
+#define ROBOT_SIM_TBL_ERR_EID           14
+#define ROBOT_SIM_COSIM_ERR_EID         15
+#define ROBOT_SIM_EVENT_SUMMARY_INF_EID 16
 
-#define ROBOT_SIM_EVENT_COUNTS 7
+#define ROBOT_SIM_EVENT_COUNTS 16
 
 #endif /* _robot_sim_events_h_ */
 
@@ -0,0 +1,90 @@
+/************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_mission_cfg.h
+**
+** Purpose:
+**  Define Robot Sim mission-wide configuration
+**
+** Notes:
+**  This header has no cFE dependencies so that host-side tools can share it.
+**
+*************************************************************************/
+#ifndef _robot_sim_mission_cfg_h_
+#define _robot_sim_mission_cfg_h_
+
+/*
+** Number of joints in the simulated arm
+*/
+#define NUM_JOINTS 7
+
+/*
+** Number of rate groups reported in housekeeping
+*/
+#define ROBOT_SIM_MAX_RATE_GROUPS 5
+
+/*
+** Configuration regions per joint with their own PID gains
+*/
+#define ROBOT_SIM_PID_REGIONS 3
+
+/*
+** Control modes
+*/
+#define ROBOT_SIM_MODE_POSITION 0 /**< Track the joint goal */
+#define ROBOT_SIM_MODE_HOLD     1 /**< Control law disabled, joints hold still */
+#define ROBOT_SIM_MODE_VELOCITY 2 /**< Track a commanded tool twist */
+
+/*
+** Physics backends
+*/
+#define ROBOT_SIM_PHYSICS_INTERNAL 0 /**< Built-in rate-limited kinematic model */
+#define ROBOT_SIM_PHYSICS_COSIM    1 /**< External process stepped in lockstep */
+#define ROBOT_SIM_PHYSICS_BACKENDS 2
+
+/*
+** Telemetry views: packets built from a commanded list of fields
+*/
+#define ROBOT_SIM_MAX_VIEWS       4
+#define ROBOT_SIM_VIEW_MAX_FIELDS 8
+#define ROBOT_SIM_VIEW_MAX_BYTES  320
+
+/*
+** View fields, packed in the order listed with no padding
+*/
+#define ROBOT_SIM_VIEW_FIELD_JOINTS   1 /**< Measured joint angles, float[NUM_JOINTS] */
+#define ROBOT_SIM_VIEW_FIELD_POSITION 2 /**< True joint angles, float[NUM_JOINTS] */
+#define ROBOT_SIM_VIEW_FIELD_GOALS    3 /**< Joint goals, float[NUM_JOINTS] */
+#define ROBOT_SIM_VIEW_FIELD_ERRORS   4 /**< Joint errors, float[NUM_JOINTS] */
+#define ROBOT_SIM_VIEW_FIELD_TORQUE   5 /**< Predicted joint torques, float[NUM_JOINTS] */
+#define ROBOT_SIM_VIEW_FIELD_POSE     6 /**< Tool frame, float R[3][3] then p[3] */
+#define ROBOT_SIM_VIEW_FIELD_TIMING   7 /**< uint32 HR tick, then RobotSimRateGroupTlm_t per rate group */
+#define ROBOT_SIM_VIEW_FIELD_COUNT    8
+
+/*
+** Event IDs with their own rate budget in the table
+*/
+#define ROBOT_SIM_EVENT_BUDGETS 8
+
+#endif /* _robot_sim_mission_cfg_h_ */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -31,6 +31,14 @@
 
 #define ROBOT_SIM_PERF_ID 91
 
+#define ROBOT_SIM_PHYSICS_PERF_ID   92
+#define ROBOT_SIM_CONTROL_PERF_ID   93
+#define ROBOT_SIM_STATE_TLM_PERF_ID 94
+#define ROBOT_SIM_RECORDER_PERF_ID  95
+#define ROBOT_SIM_REC_DUMP_PERF_ID  96
+#define ROBOT_SIM_TBL_LOAD_PERF_ID  97
+#define ROBOT_SIM_VIEW_PERF_ID      98
+
 #endif /* _robot_sim_perfids_h_ */
 
 /************************/
@@ -0,0 +1,82 @@
+/************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_rec_format.h
+**
+** Purpose:
+**  Define the layout of state recorder dump files
+**
+** Notes:
+**  A dump file is a standard cFE file header, followed by one
+**  RobotSimRecFileHdr_t, followed by NumRecords RobotSimRecRecord_t in
+**  time order. All fields are in the byte order of the processor that
+**  wrote the file. This header has no cFE dependencies so that the ground
+**  converter (tools/robot_sim_rec2csv) can share it.
+**
+*************************************************************************/
+#ifndef _robot_sim_rec_format_h_
+#define _robot_sim_rec_format_h_
+
+#include "robot_sim_mission_cfg.h"
+
+#include <stdint.h>
+
+#define ROBOT_SIM_REC_MAGIC   0x52535243 /* "RSRC" */
+#define ROBOT_SIM_REC_VERSION 1
+
+/*
+** cFE file header subtype of recorder dumps
+*/
+#define ROBOT_SIM_REC_FS_SUBTYPE 0x5253
+
+/*
+** Marks a dump that does not contain a trigger
+*/
+#define ROBOT_SIM_REC_NO_TRIGGER 0xFFFFFFFF
+
+typedef struct
+{
+    uint32_t Magic;
+    uint16_t Version;
+    uint16_t NumJoints;
+    uint32_t RecordSize;
+    uint32_t NumRecords;
+    uint32_t TriggerIndex; /**< Record index of the trigger, or ROBOT_SIM_REC_NO_TRIGGER */
+    uint32_t FirstSequence; /**< HR tick count of the first record */
+} RobotSimRecFileHdr_t;
+
+/*
+** One HR tick sample
+*/
+typedef struct
+{
+    uint32_t Sequence; /**< HR ticks recorded since startup */
+    uint32_t Seconds;  /**< cFE time of the sample */
+    uint32_t Subseconds;
+    float    Position[NUM_JOINTS];
+    float    Goal[NUM_JOINTS];
+    float    Error[NUM_JOINTS];
+} RobotSimRecRecord_t;
+
+#endif /* _robot_sim_rec_format_h_ */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,107 @@
+/************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_platform_cfg.h
+**
+** Purpose:
+**  Define Robot Sim platform configuration
+**
+** Notes:
+**
+*************************************************************************/
+#ifndef _robot_sim_platform_cfg_h_
+#define _robot_sim_platform_cfg_h_
+
+/*
+** Period of the ROBOT_SIM_HR_CONTROL_MID wakeup, in microseconds.
+** Each rate group is budgeted Divisor times this period.
+*/
+#define ROBOT_SIM_HR_PERIOD_USEC 1000
+
+/*
+** Rate divisors and phase offsets of the HR stages. A stage runs on the
+** wakeups where (tick % Divisor) == Phase.
+*/
+#define ROBOT_SIM_PHYSICS_DIVISOR   1
+#define ROBOT_SIM_PHYSICS_PHASE     0
+#define ROBOT_SIM_CONTROL_DIVISOR   1
+#define ROBOT_SIM_CONTROL_PHASE     0
+#define ROBOT_SIM_STATE_TLM_DIVISOR 1
+#define ROBOT_SIM_STATE_TLM_PHASE   0
+
+/*
+** Seconds covered by one physics step, converts rates to model increments
+*/
+#define ROBOT_SIM_PHYSICS_DT (1.0e-6f * ROBOT_SIM_HR_PERIOD_USEC * ROBOT_SIM_PHYSICS_DIVISOR)
+
+/*
+** Depth of the control request queue between command handling and the
+** HR loop. Must be a power of two, and at least the command pipe depth
+** so a full pipe of commands handled within one HR tick always fits.
+*/
+#define ROBOT_SIM_CTRL_QUEUE_DEPTH 32
+
+/*
+** Sensor model: longest encoder latency in telemetry samples (power of
+** two) and the PRNG seed used at startup
+*/
+#define ROBOT_SIM_SENSOR_MAX_DELAY    16
+#define ROBOT_SIM_SENSOR_DEFAULT_SEED 0x5EED
+
+/*
+** State recorder: HR samples kept in the on-board ring (power of two)
+** and the rate group it runs in
+*/
+#define ROBOT_SIM_REC_DEPTH   8192
+#define ROBOT_SIM_REC_DIVISOR 1
+#define ROBOT_SIM_REC_PHASE   0
+
+/*
+** Velocity mode: metres per radian weighting the angular part of the
+** twist, damped least squares lambda^2, and the Jacobian condition
+** numbers where tool rates start to be scaled down and reach zero
+*/
+#define ROBOT_SIM_VEL_LENGTH_SCALE 5.0f
+#define ROBOT_SIM_VEL_DAMPING      1.0e-4f
+#define ROBOT_SIM_VEL_COND_SLOW    50.0f
+#define ROBOT_SIM_VEL_COND_STOP    400.0f
+
+/*
+** Data cache line size of the target, used to lay out hot state
+*/
+#define ROBOT_SIM_CACHE_LINE 64
+
+/*
+** Kinematic model table image loaded at startup
+*/
+#define ROBOT_SIM_TABLE_FILE "/cf/robot_sim_tbl.tbl"
+
+/*
+** Co-simulation: socket of the external physics process when none is
+** commanded, and how long a lockstep tick may wait for it
+*/
+#define ROBOT_SIM_COSIM_PATH         "/tmp/robot_sim_cosim.sock"
+#define ROBOT_SIM_COSIM_TIMEOUT_MSEC 10
+
+#endif /* _robot_sim_platform_cfg_h_ */
+
+/************************/
+/*  End of File Comment */
+/************************/
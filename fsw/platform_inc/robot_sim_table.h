@@ -24,20 +24,90 @@
 **  Define robot sim table
 **
 ** Notes:
-**
+**  The table holds the kinematic and inertial description of the arm and
+**  the joint controller gains. It is built into a binary image by
+**  elf2cfetbl at build time and used in place by the app, so nothing is
+**  parsed at startup. Only standard C types are used so that host tools
+**  can share the layout.
 **
 *******************************************************************************/
 #ifndef _robot_sim_table_h_
 #define _robot_sim_table_h_
 
+#include "robot_sim_mission_cfg.h"
+
+#include <stdint.h>
+
+/*
+** Joint types
+*/
+#define ROBOT_SIM_JOINT_REVOLUTE 0
+
+/*
+** Control gains of one joint. Region r covers angles above Breakpoint[r-1]
+** and up to Breakpoint[r]; gains are per control tick.
+*/
+typedef struct
+{
+    float Breakpoint[ROBOT_SIM_PID_REGIONS - 1]; /**< Ascending, rad */
+    float Kp[ROBOT_SIM_PID_REGIONS];
+    float Ki[ROBOT_SIM_PID_REGIONS];
+    float Kd[ROBOT_SIM_PID_REGIONS];
+    float IntegratorLimit; /**< Clamp on the integral term, rad per tick */
+    float MaxRate;         /**< Joint rate limit, rad/s */
+    float BackCalcGain;    /**< Anti-windup back-calculation gain, 0..1 */
+    float VelFF;           /**< Goal rate feedforward gain */
+    float AccFF;           /**< Goal acceleration feedforward gain */
+} RobotSimJointGains_t;
+
+/*
+** One joint and the link it moves
+*/
+typedef struct
+{
+    uint32_t Type;       /**< ROBOT_SIM_JOINT_* */
+    float    Origin[3];  /**< Joint origin in the parent link frame, m */
+    float    Axis[3];    /**< Unit rotation axis in the parent link frame */
+    float    MinAngle;   /**< Joint limits, rad */
+    float    MaxAngle;
+    float    Mass;       /**< Link mass, kg */
+    float    Com[3];     /**< Link centre of mass in the link frame, m */
+    float    Inertia[6]; /**< Link inertia about the CoM: xx, yy, zz, xy, xz, yz, kg m^2 */
+    float    MaxTorque;  /**< Joint drive torque limit, N m */
+
+    RobotSimJointGains_t Gains;
+} RobotSimJointDesc_t;
+
+/*
+** Event budget flags
+*/
+#define ROBOT_SIM_EVENT_CONFIRM 0x0001 /**< Per-command confirmation, counted instead of sent in quiet mode */
+
+/*
+** Token bucket of one event ID: up to Burst events at once, refilled by
+** Rate events every housekeeping request. Events not listed are not
+** limited; an EventID of 0 marks an unused entry.
+*/
+typedef struct
+{
+    uint16_t EventID;
+    uint16_t Flags; /**< ROBOT_SIM_EVENT_* */
+    uint16_t Rate;
+    uint16_t Burst;
+} RobotSimEventBudget_t;
+
 /*
 ** Table structure
 */
 typedef struct
 {
-    uint16 Int1;
-    uint16 Int2;
+    uint32_t            NumJoints; /**< Must equal NUM_JOINTS */
+    uint32_t            Spare;
+    RobotSimJointDesc_t Joints[NUM_JOINTS];
+    float               ToolOffset[3]; /**< Tool frame origin in the last link frame, m */
+    float               Spare2;
 
+    RobotSimEventBudget_t Events[ROBOT_SIM_EVENT_BUDGETS];
 } RobotSimTable_t;
 
 #endif /* _robot_sim_table_h_ */
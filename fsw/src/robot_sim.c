@@ -32,7 +32,11 @@
 #include "robot_sim_version.h"
 #include "robot_sim.h"
 #include "robot_sim_table.h"
+#include "robot_sim_platform_cfg.h"
 
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdio.h>
 #include <string.h>
 
 #include <math.h>
@@ -41,11 +45,97 @@
 ** global data
 */
 RobotSimData_t RobotSimData;
-RobotSimData_t RobotSimGoal;
 RobotSimTlmState_t StateMsg;
-float Kp = 0.01;
 
-void HighRateControLoop(void);
+/*
+** The model arrays are copied straight into the joint structs of the messages
+*/
+CompileTimeAssert(sizeof(RobotSimSSRMS_t) == sizeof(float) * NUM_JOINTS, RobotSimSSRMSLayout);
+CompileTimeAssert(sizeof(RobotSimPidTlm_t) == sizeof(RobotSimPidTerms_t), RobotSimPidTlmLayout);
+
+/*
+** Every command read from the pipe between two HR ticks can post a request
+*/
+CompileTimeAssert(ROBOT_SIM_CTRL_QUEUE_DEPTH >= ROBOT_SIM_PIPE_DEPTH, RobotSimCtrlQueueDepth);
+
+/*
+** Bytes of the hot block at the start of the app data
+*/
+#define ROBOT_SIM_HOT_BYTES    offsetof(RobotSimData_t, HkTlm)
+#define ROBOT_SIM_LINES(Bytes) (((Bytes) + ROBOT_SIM_CACHE_LINE - 1) / ROBOT_SIM_CACHE_LINE)
+
+static const RobotSimVelConfig_t RobotSimVelDefaultConfig = {ROBOT_SIM_VEL_LENGTH_SCALE, ROBOT_SIM_VEL_DAMPING,
+                                                             ROBOT_SIM_VEL_COND_SLOW, ROBOT_SIM_VEL_COND_STOP};
+
+/*
+** Ground command handlers take their own message type. Each gets a thin
+** entry point with the dispatcher's signature that converts the buffer,
+** which the dispatcher only passes on after checking its length.
+*/
+#define ROBOT_SIM_CMD_ENTRY(Handler, Type)                              \
+    static int32 Handler##Entry(const CFE_SB_Buffer_t *SBBufPtr)        \
+    {                                                                   \
+        return Handler((const Type *)SBBufPtr);                         \
+    }
+
+ROBOT_SIM_CMD_ENTRY(RobotSimNoop, RobotSimNoopCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdJointState, RobotSimJointStateCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSetKp, RobotSimSetKpCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSetMode, RobotSimSetModeCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdStop, RobotSimStopCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSetSensor, RobotSimSetSensorCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSensorFault, RobotSimSensorFaultCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSensorSeed, RobotSimSensorSeedCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdRecTrigger, RobotSimRecTriggerCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdRecFreeze, RobotSimRecFreezeCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdRecTrim, RobotSimRecTrimCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdRecDump, RobotSimRecDumpCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSetTwist, RobotSimSetTwistCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSetTrajectory, RobotSimSetTrajectoryCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdGrapple, RobotSimGrappleCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdRelease, RobotSimReleaseCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSetPhysics, RobotSimSetPhysicsCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdSetEventMode, RobotSimSetEventModeCmd_t)
+ROBOT_SIM_CMD_ENTRY(RobotSimCmdDefineView, RobotSimDefineViewCmd_t)
+
+/*
+** Ground commands by command code
+*/
+#define ROBOT_SIM_CMD(Handler, Type) {Handler##Entry, sizeof(Type), sizeof(Type)}
+
+static const RobotSimCmdEntry_t RobotSimCmdTable[ROBOT_SIM_NUM_CMD_CODES] = {
+    [ROBOT_SIM_NOOP_CC]           = ROBOT_SIM_CMD(RobotSimNoop, RobotSimNoopCmd_t),
+    [ROBOT_SIM_SET_JOINTS_CC]     = ROBOT_SIM_CMD(RobotSimCmdJointState, RobotSimJointStateCmd_t),
+    [ROBOT_SIM_SET_KP_CC]         = ROBOT_SIM_CMD(RobotSimCmdSetKp, RobotSimSetKpCmd_t),
+    [ROBOT_SIM_SET_MODE_CC]       = ROBOT_SIM_CMD(RobotSimCmdSetMode, RobotSimSetModeCmd_t),
+    [ROBOT_SIM_STOP_CC]           = ROBOT_SIM_CMD(RobotSimCmdStop, RobotSimStopCmd_t),
+    [ROBOT_SIM_SET_SENSOR_CC]     = ROBOT_SIM_CMD(RobotSimCmdSetSensor, RobotSimSetSensorCmd_t),
+    [ROBOT_SIM_SENSOR_FAULT_CC]   = ROBOT_SIM_CMD(RobotSimCmdSensorFault, RobotSimSensorFaultCmd_t),
+    [ROBOT_SIM_SENSOR_SEED_CC]    = ROBOT_SIM_CMD(RobotSimCmdSensorSeed, RobotSimSensorSeedCmd_t),
+    [ROBOT_SIM_REC_TRIGGER_CC]    = ROBOT_SIM_CMD(RobotSimCmdRecTrigger, RobotSimRecTriggerCmd_t),
+    [ROBOT_SIM_REC_FREEZE_CC]     = ROBOT_SIM_CMD(RobotSimCmdRecFreeze, RobotSimRecFreezeCmd_t),
+    [ROBOT_SIM_REC_TRIM_CC]       = ROBOT_SIM_CMD(RobotSimCmdRecTrim, RobotSimRecTrimCmd_t),
+    [ROBOT_SIM_REC_DUMP_CC]       = ROBOT_SIM_CMD(RobotSimCmdRecDump, RobotSimRecDumpCmd_t),
+    [ROBOT_SIM_SET_TWIST_CC]      = ROBOT_SIM_CMD(RobotSimCmdSetTwist, RobotSimSetTwistCmd_t),
+    [ROBOT_SIM_SET_TRAJECTORY_CC] = ROBOT_SIM_CMD(RobotSimCmdSetTrajectory, RobotSimSetTrajectoryCmd_t),
+    [ROBOT_SIM_GRAPPLE_CC]        = ROBOT_SIM_CMD(RobotSimCmdGrapple, RobotSimGrappleCmd_t),
+    [ROBOT_SIM_RELEASE_CC]        = ROBOT_SIM_CMD(RobotSimCmdRelease, RobotSimReleaseCmd_t),
+    [ROBOT_SIM_SET_PHYSICS_CC]    = ROBOT_SIM_CMD(RobotSimCmdSetPhysics, RobotSimSetPhysicsCmd_t),
+    [ROBOT_SIM_SET_EVENT_MODE_CC] = ROBOT_SIM_CMD(RobotSimCmdSetEventMode, RobotSimSetEventModeCmd_t),
+
+    /*
+    ** Variable length: the command may stop after its last field
+    */
+    [ROBOT_SIM_DEFINE_VIEW_CC] = {RobotSimCmdDefineViewEntry, offsetof(RobotSimDefineViewCmd_t, Fields),
+                                  sizeof(RobotSimDefineViewCmd_t)},
+};
+
+static const RobotSimPhysicsBackend_t RobotSimPhysicsBackends[ROBOT_SIM_PHYSICS_BACKENDS] = {
+    [ROBOT_SIM_PHYSICS_INTERNAL] = {"internal", RobotSimInternalPhysics},
+#ifdef ROBOT_SIM_COSIM_ENABLED
+    [ROBOT_SIM_PHYSICS_COSIM] = {"co-simulation", RobotSimCosimPhysics},
+#endif
+};
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *  * *  * * * * **/
 /* RobotSimMain() -- Application entry point and main process loop         */
@@ -92,7 +182,7 @@ void RobotSimMain(void)
         }
         else
         {
-            CFE_EVS_SendEvent(ROBOT_SIM_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
+            RobotSimSendEvent(ROBOT_SIM_PIPE_ERR_EID, CFE_EVS_EventType_ERROR,
                               "Robot Sim: SB Pipe Read Error, App Will Exit");
 
             RobotSimData.RunStatus = CFE_ES_RunStatus_APP_ERROR;
@@ -130,6 +220,7 @@ int32 RobotSimInit(void)
     */
     RobotSimData.CmdCounter = 0;
     RobotSimData.ErrCounter = 0;
+    memset(RobotSimData.CmdStats, 0, sizeof(RobotSimData.CmdStats));
     RobotSimData.square_counter = 0;
     RobotSimData.hk_counter = 0;
     RobotSimData.angle = 0.0;
@@ -142,6 +233,55 @@ int32 RobotSimInit(void)
     RobotSimData.HkTlm.Payload.state.joint5 = 0.0;
     RobotSimData.HkTlm.Payload.state.joint6 = 0.0;
 
+    RobotSimModelInit(&RobotSimData.Model, ROBOT_SIM_DEFAULT_KP);
+    RobotSimCmdQueueInit(&RobotSimData.CtrlQueue);
+    RobotSimSensorInit(&RobotSimData.Sensor, ROBOT_SIM_SENSOR_DEFAULT_SEED);
+    RobotSimRecInit(&RobotSimData.Recorder);
+    RobotSimVelInit(&RobotSimData.Vel, &RobotSimVelDefaultConfig);
+#ifdef ROBOT_SIM_COSIM_ENABLED
+    RobotSimCosimInit(&RobotSimData.Cosim);
+#endif
+    RobotSimEvLimInit(&RobotSimData.EvLim);
+    RobotSimData.Physics = &RobotSimPhysicsBackends[ROBOT_SIM_PHYSICS_INTERNAL];
+
+    /*
+    ** Register the HR stages. Stages due on the same tick run in this
+    ** order, which matches RobotSimModelStep() when all divisors are 1.
+    */
+    RobotSimSchedInit(&RobotSimData.Sched);
+
+    status = RobotSimSchedRegister(&RobotSimData.Sched, RobotSimControlStage, ROBOT_SIM_CONTROL_DIVISOR,
+                                   ROBOT_SIM_CONTROL_PHASE, ROBOT_SIM_CONTROL_PERF_ID);
+    if (status == CFE_SUCCESS)
+    {
+        status = RobotSimSchedRegister(&RobotSimData.Sched, RobotSimPhysicsStage, ROBOT_SIM_PHYSICS_DIVISOR,
+                                       ROBOT_SIM_PHYSICS_PHASE, ROBOT_SIM_PHYSICS_PERF_ID);
+    }
+    if (status == CFE_SUCCESS)
+    {
+        status = RobotSimSchedRegister(&RobotSimData.Sched, RobotSimStateTlmStage, ROBOT_SIM_STATE_TLM_DIVISOR,
+                                       ROBOT_SIM_STATE_TLM_PHASE, ROBOT_SIM_STATE_TLM_PERF_ID);
+    }
+    if (status == CFE_SUCCESS)
+    {
+        status = RobotSimSchedRegister(&RobotSimData.Sched, RobotSimRecorderStage, ROBOT_SIM_REC_DIVISOR,
+                                       ROBOT_SIM_REC_PHASE, ROBOT_SIM_RECORDER_PERF_ID);
+    }
+    if (status == CFE_SUCCESS)
+    {
+        /*
+        ** Every tick: each view counts down its own rate divisor
+        */
+        status = RobotSimSchedRegister(&RobotSimData.Sched, RobotSimViewStage, 1, 0, ROBOT_SIM_VIEW_PERF_ID);
+    }
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Robot Sim: Invalid rate group configuration, RC = 0x%08lX\n", (unsigned long)status);
+        return (status);
+    }
+
+    RobotSimViewsInit();
+
     /*
     ** Initialize app configuration data
     */
@@ -167,6 +307,24 @@ int32 RobotSimInit(void)
     RobotSimData.EventFilters[5].Mask    = 0x0000;
     RobotSimData.EventFilters[6].EventID = ROBOT_SIM_PIPE_ERR_EID;
     RobotSimData.EventFilters[6].Mask    = 0x0000;
+    RobotSimData.EventFilters[7].EventID = ROBOT_SIM_COMMANDCTL_INF_EID;
+    RobotSimData.EventFilters[7].Mask    = 0x0000;
+    RobotSimData.EventFilters[8].EventID = ROBOT_SIM_CTRL_QUEUE_ERR_EID;
+    RobotSimData.EventFilters[8].Mask    = 0x0000;
+    RobotSimData.EventFilters[9].EventID = ROBOT_SIM_SENSOR_INF_EID;
+    RobotSimData.EventFilters[9].Mask    = 0x0000;
+    RobotSimData.EventFilters[10].EventID = ROBOT_SIM_REC_INF_EID;
+    RobotSimData.EventFilters[10].Mask    = 0x0000;
+    RobotSimData.EventFilters[11].EventID = ROBOT_SIM_REC_ERR_EID;
+    RobotSimData.EventFilters[11].Mask    = 0x0000;
+    RobotSimData.EventFilters[12].EventID = ROBOT_SIM_TBL_INF_EID;
+    RobotSimData.EventFilters[12].Mask    = 0x0000;
+    RobotSimData.EventFilters[13].EventID = ROBOT_SIM_TBL_ERR_EID;
+    RobotSimData.EventFilters[13].Mask    = 0x0000;
+    RobotSimData.EventFilters[14].EventID = ROBOT_SIM_COSIM_ERR_EID;
+    RobotSimData.EventFilters[14].Mask    = 0x0000;
+    RobotSimData.EventFilters[15].EventID = ROBOT_SIM_EVENT_SUMMARY_INF_EID;
+    RobotSimData.EventFilters[15].Mask    = 0x0000;
 
     status = CFE_EVS_Register(RobotSimData.EventFilters, ROBOT_SIM_EVENT_COUNTS, CFE_EVS_EventFilter_BINARY);
     if (status != CFE_SUCCESS)
@@ -175,6 +333,15 @@ int32 RobotSimInit(void)
         return (status);
     }
 
+    /*
+    ** Load the kinematic model before the HR loop can run
+    */
+    status = RobotSimTblInit();
+    if (status != CFE_SUCCESS)
+    {
+        return (status);
+    }
+
     /*
     ** Initialize housekeeping packet (clear user data area).
     */
@@ -223,7 +390,23 @@ int32 RobotSimInit(void)
         return (status);
     }
 
-    CFE_EVS_SendEvent(ROBOT_SIM_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION, "Robot Sim Initialized.%s",
+    /*
+    ** Static footprint, fixed at build time
+    */
+    CFE_ES_WriteToSysLog("Robot Sim: hot state %lu bytes in %lu cache lines (model %lu, kin %lu, dyn %lu, "
+                         "sensor %lu, sched %lu, vel %lu, queue %lu)\n",
+                         (unsigned long)ROBOT_SIM_HOT_BYTES, (unsigned long)ROBOT_SIM_LINES(ROBOT_SIM_HOT_BYTES),
+                         (unsigned long)sizeof(RobotSimModel_t), (unsigned long)sizeof(RobotSimKin_t),
+                         (unsigned long)sizeof(RobotSimDyn_t), (unsigned long)sizeof(RobotSimSensor_t),
+                         (unsigned long)sizeof(RobotSimSched_t), (unsigned long)sizeof(RobotSimVel_t),
+                         (unsigned long)sizeof(RobotSimCmdQueue_t));
+    CFE_ES_WriteToSysLog("Robot Sim: cold state %lu bytes (recorder %lu, views %lu), state packet %lu bytes\n",
+                         (unsigned long)(sizeof(RobotSimData_t) - ROBOT_SIM_HOT_BYTES),
+                         (unsigned long)sizeof(RobotSimRec_t),
+                         (unsigned long)(sizeof(RobotSimData.Views) + sizeof(RobotSimData.ViewPkts)),
+                         (unsigned long)sizeof(RobotSimTlmState_t));
+
+    RobotSimSendEvent(ROBOT_SIM_STARTUP_INF_EID, CFE_EVS_EventType_INFORMATION, "Robot Sim Initialized.%s",
                       ROBOT_SIM_VERSION_STRING);
 
     return (CFE_SUCCESS);
@@ -260,7 +443,7 @@ void RobotSimProcessCommandPacket(CFE_SB_Buffer_t *SBBufPtr)
             break;
             
         default:
-            CFE_EVS_SendEvent(ROBOT_SIM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_ERROR,
+            RobotSimSendEvent(ROBOT_SIM_INVALID_MSGID_ERR_EID, CFE_EVS_EventType_ERROR,
                               "robot sim: invalid command packet,MID = 0x%x", (unsigned int)CFE_SB_MsgIdToValue(MsgId));
             break;
     }
@@ -277,42 +460,47 @@ void RobotSimProcessCommandPacket(CFE_SB_Buffer_t *SBBufPtr)
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 void RobotSimProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
 {
-    CFE_MSG_FcnCode_t CommandCode = 0;
+    const RobotSimCmdEntry_t *Entry;
+    RobotSimCmdStatsTlm_t    *Stats;
+    CFE_MSG_FcnCode_t         CommandCode = 0;
+    OS_time_t                 Start;
+    OS_time_t                 Stop;
+    int32                     status;
 
     CFE_MSG_GetFcnCode(&SBBufPtr->Msg, &CommandCode);
 
-    printf("RobotSimProcessGroundCommand() -- we're getting a ground command...%d\n", CommandCode);
-
-    /*
-    ** Process "known" ros app ground commands
-    */
-    switch (CommandCode)
+    if (CommandCode >= ROBOT_SIM_NUM_CMD_CODES || RobotSimCmdTable[CommandCode].Handler == NULL)
     {
-        case ROBOT_SIM_NOOP_CC:
-            if (RobotSimVerifyCmdLength(&SBBufPtr->Msg, sizeof(RobotSimNoopCmd_t)))
-            {
-                RobotSimNoop((RobotSimNoopCmd_t *)SBBufPtr);
-            }
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "Invalid ground command code: CC = %d",
+                          CommandCode);
+        RobotSimData.ErrCounter++;
+        return;
+    }
 
-            break;
+    Entry = &RobotSimCmdTable[CommandCode];
+    Stats = &RobotSimData.CmdStats[CommandCode];
 
-        case ROBOT_SIM_SET_JOINTS_CC:
-            // if (RobotSimVerifyCmdLength(&SBBufPtr->Msg, sizeof(RobotSimJointStateCmd_t)))
-            {
-                RobotSimCmdJointState((RobotSimJointStateCmd_t *)SBBufPtr);
-            }
+    if (!RobotSimVerifyCmdLength(&SBBufPtr->Msg, Entry->MinLength, Entry->MaxLength))
+    {
+        Stats->RejectCount++;
+        return;
+    }
 
-            break;
+    CFE_PSP_GetTime(&Start);
 
-        /* default case already found during FC vs length test */
-        default:
-            CFE_EVS_SendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
-                              "Invalid ground command code: CC = %d", CommandCode);
-            break;
-    }
+    status = Entry->Handler(SBBufPtr);
 
+    CFE_PSP_GetTime(&Stop);
 
-    return;
+    Stats->ExecTimeUsec += (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Stop, Start));
+    if (status == CFE_SUCCESS)
+    {
+        Stats->AcceptCount++;
+    }
+    else
+    {
+        Stats->RejectCount++;
+    }
 
 } /* End of RobotSimProcessGroundCommand() */
 
@@ -328,6 +516,8 @@ void RobotSimProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr)
 /* * * * * * * * * * * * * * * * * * * * * * * *  * * * * * * *  * *  * * * * */
 int32 RobotSimReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
 {
+    int i;
+
     printf("RobotSimReportHousekeeping() -- sending joint states as part of housekeeping...\n");
     
     /*
@@ -337,6 +527,49 @@ int32 RobotSimReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
     RobotSimData.ErrCounter++;
     RobotSimData.HkTlm.Payload.CommandCounter      = RobotSimData.CmdCounter++;
 
+    memcpy(&RobotSimData.HkTlm.Payload.state, RobotSimData.Model.Position, sizeof(RobotSimSSRMS_t));
+
+    RobotSimSchedReport(&RobotSimData.Sched, RobotSimData.HkTlm.Payload.RateGroups);
+
+    RobotSimData.HkTlm.Payload.CtrlQueueOverflowCount = RobotSimData.CtrlQueue.OverflowCount;
+    RobotSimData.HkTlm.Payload.CtrlQueueHighWater     = RobotSimData.CtrlQueue.HighWater;
+    RobotSimData.HkTlm.Payload.SensorDropoutCount     = RobotSimData.Sensor.DropoutCount;
+    RobotSimData.HkTlm.Payload.SensorFaultMask        = 0;
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        if (RobotSimData.Sensor.Fault[i] != ROBOT_SIM_SENSOR_FAULT_NONE)
+        {
+            RobotSimData.HkTlm.Payload.SensorFaultMask |= (1u << i);
+        }
+    }
+    RobotSimData.HkTlm.Payload.RecSequence = RobotSimData.Recorder.Head;
+    RobotSimData.HkTlm.Payload.RecFrozen   = RobotSimData.Recorder.Frozen;
+
+    RobotSimData.HkTlm.Payload.KinHitCount       = RobotSimData.Kin.HitCount;
+    RobotSimData.HkTlm.Payload.KinMissCount      = RobotSimData.Kin.MissCount;
+    RobotSimData.HkTlm.Payload.KinRecomputeCount = RobotSimData.Kin.RecomputeCount;
+    RobotSimData.HkTlm.Payload.TblLoadTimeUsec   = RobotSimData.TblLoadTimeUsec;
+    RobotSimData.HkTlm.Payload.TblUpdateCount    = RobotSimData.TblUpdateCount;
+
+    RobotSimData.HkTlm.Payload.PayloadMass       = RobotSimData.Dyn.Grappled ? RobotSimData.Dyn.Payload.Mass : 0.0f;
+    RobotSimData.HkTlm.Payload.VelManipulability = RobotSimData.Vel.Manipulability;
+    RobotSimData.HkTlm.Payload.VelCondition      = RobotSimData.Vel.Condition;
+    RobotSimData.HkTlm.Payload.VelScale          = RobotSimData.Vel.Scale;
+    RobotSimData.HkTlm.Payload.VelScaledCount    = RobotSimData.Vel.ScaledCount;
+    RobotSimData.HkTlm.Payload.ViewPacketCount   = RobotSimData.ViewPacketCount;
+
+    RobotSimData.HkTlm.Payload.PhysicsBackend         = (uint32)(RobotSimData.Physics - RobotSimPhysicsBackends);
+    RobotSimData.HkTlm.Payload.CosimStepCount         = RobotSimData.Cosim.StepCount;
+    RobotSimData.HkTlm.Payload.CosimFailCount         = RobotSimData.CosimFailCount;
+    RobotSimData.HkTlm.Payload.CosimLastRoundTripUsec = RobotSimData.Cosim.LastRoundTripUsec;
+    RobotSimData.HkTlm.Payload.CosimMaxRoundTripUsec  = RobotSimData.Cosim.MaxRoundTripUsec;
+
+    RobotSimData.HkTlm.Payload.EventQuietMode       = RobotSimData.EvLim.Quiet;
+    RobotSimData.HkTlm.Payload.EventSuppressedCount = RobotSimData.EvLim.SuppressedTotal;
+    RobotSimData.HkTlm.Payload.EventQuietCount      = RobotSimData.EvLim.QuietTotal;
+
+    memcpy(RobotSimData.HkTlm.Payload.CmdStats, RobotSimData.CmdStats, sizeof(RobotSimData.HkTlm.Payload.CmdStats));
+
     OS_printf("RobotSimReportHousekeeping reporting: %d\n", RobotSimData.HkTlm.Payload.CommandCounter);
 
     /*
@@ -353,11 +586,168 @@ int32 RobotSimReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
     CFE_SB_TimeStampMsg(&RobotSimData.HkTlm.TlmHeader.Msg);
     CFE_SB_TransmitMsg(&RobotSimData.HkTlm.TlmHeader.Msg, true);
 
+    RobotSimEventSummary();
+    RobotSimTblManage();
+
     return CFE_SUCCESS;
 
 } /* End of RobotSimReportHousekeeping() */
 
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimTblInit() -- register, load and bind the kinematic model table     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimTblInit(void)
+{
+    OS_time_t Start;
+    OS_time_t Stop;
+    int32     status;
+
+    CFE_ES_PerfLogEntry(ROBOT_SIM_TBL_LOAD_PERF_ID);
+    CFE_PSP_GetTime(&Start);
+
+    status = CFE_TBL_Register(&RobotSimData.TblHandle, "RobotSimTable", sizeof(RobotSimTable_t), CFE_TBL_OPT_DEFAULT,
+                              RobotSimTblValidate);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Robot Sim: Error Registering Table, RC = 0x%08lX\n", (unsigned long)status);
+        return (status);
+    }
+
+    /*
+    ** The image is the binary model built by elf2cfetbl; it is used in
+    ** place, so there is nothing to parse or convert at startup
+    */
+    status = CFE_TBL_Load(RobotSimData.TblHandle, CFE_TBL_SRC_FILE, ROBOT_SIM_TABLE_FILE);
+    if (status != CFE_SUCCESS)
+    {
+        CFE_ES_WriteToSysLog("Robot Sim: Error Loading Table %s, RC = 0x%08lX\n", ROBOT_SIM_TABLE_FILE,
+                             (unsigned long)status);
+        return (status);
+    }
+
+    status = CFE_TBL_GetAddress((void **)&RobotSimData.TblPtr, RobotSimData.TblHandle);
+    if (status != CFE_SUCCESS && status != CFE_TBL_INFO_UPDATED)
+    {
+        CFE_ES_WriteToSysLog("Robot Sim: Error Getting Table Address, RC = 0x%08lX\n", (unsigned long)status);
+        return (status);
+    }
+
+    RobotSimKinInit(&RobotSimData.Kin, RobotSimData.TblPtr);
+    RobotSimDynInit(&RobotSimData.Dyn, RobotSimData.TblPtr);
+    RobotSimTblApply(RobotSimData.TblPtr);
+
+    CFE_PSP_GetTime(&Stop);
+    CFE_ES_PerfLogExit(ROBOT_SIM_TBL_LOAD_PERF_ID);
+
+    RobotSimData.TblLoadTimeUsec = (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Stop, Start));
+
+    RobotSimSendEvent(ROBOT_SIM_TBL_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "Robot Sim: kinematic model loaded from %s in %lu usec", ROBOT_SIM_TABLE_FILE,
+                      (unsigned long)RobotSimData.TblLoadTimeUsec);
+
+    return (CFE_SUCCESS);
+
+} /* End of RobotSimTblInit() */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimTblValidate() -- table services validation callback                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimTblValidate(void *TblData)
+{
+    const RobotSimTable_t      *Tbl = TblData;
+    const RobotSimJointGains_t *Gains;
+    bool                        Valid;
+    int                         i;
+    int                         r;
+
+    Valid = RobotSimKinValidate(Tbl);
+
+    for (i = 0; Valid && i < NUM_JOINTS; i++)
+    {
+        Gains = &Tbl->Joints[i].Gains;
+
+        Valid = Tbl->Joints[i].MaxTorque > 0.0f && Gains->MaxRate > 0.0f && Gains->IntegratorLimit >= 0.0f &&
+                Gains->BackCalcGain >= 0.0f && Gains->BackCalcGain <= 1.0f;
+        for (r = 0; Valid && r < ROBOT_SIM_PID_REGIONS; r++)
+        {
+            Valid = Gains->Kp[r] >= 0.0f && Gains->Ki[r] >= 0.0f && Gains->Kd[r] >= 0.0f;
+        }
+        for (r = 1; Valid && r < ROBOT_SIM_PID_REGIONS - 1; r++)
+        {
+            Valid = Gains->Breakpoint[r - 1] < Gains->Breakpoint[r];
+        }
+    }
+
+    Valid = Valid && RobotSimEvLimValidate(Tbl->Events);
+
+    if (!Valid)
+    {
+        RobotSimSendEvent(ROBOT_SIM_TBL_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Robot Sim: kinematic model rejected, joints %lu", (unsigned long)Tbl->NumJoints);
+
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of RobotSimTblValidate() */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimTblApply() -- push table contents into the model core              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimTblApply(const RobotSimTable_t *Tbl)
+{
+    RobotSimModelApplyTable(&RobotSimData.Model, Tbl, ROBOT_SIM_PHYSICS_DT);
+
+    RobotSimEvLimConfigure(&RobotSimData.EvLim, Tbl->Events);
+
+} /* End of RobotSimTblApply() */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimTblManage() -- let table services swap in a pending model          */
+/*                                                                            */
+/*  The HR wakeup arrives on the same pipe, so no stage is running while the  */
+/*  address is released and the frame cache is rebound.                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimTblManage(void)
+{
+    int32 status;
+
+    CFE_TBL_ReleaseAddress(RobotSimData.TblHandle);
+    CFE_TBL_Manage(RobotSimData.TblHandle);
+
+    status = CFE_TBL_GetAddress((void **)&RobotSimData.TblPtr, RobotSimData.TblHandle);
+    if (status == CFE_TBL_INFO_UPDATED)
+    {
+        RobotSimKinBind(&RobotSimData.Kin, RobotSimData.TblPtr);
+        RobotSimDynBind(&RobotSimData.Dyn, RobotSimData.TblPtr);
+        RobotSimTblApply(RobotSimData.TblPtr);
+        RobotSimData.TblUpdateCount++;
+
+        RobotSimSendEvent(ROBOT_SIM_TBL_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "Robot Sim: kinematic model updated");
+    }
+    else if (status != CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_TBL_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Robot Sim: kinematic model unavailable, RC = 0x%08lX", (unsigned long)status);
+    }
+
+} /* End of RobotSimTblManage() */
+
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
 /* RobotSimNoop -- ROS NOOP commands                                          */
@@ -365,7 +755,7 @@ int32 RobotSimReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg)
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 int32 RobotSimNoop(const RobotSimNoopCmd_t *Msg)
 {
-    CFE_EVS_SendEvent(ROBOT_SIM_COMMANDNOP_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: NOOP command %s",
+    RobotSimSendEvent(ROBOT_SIM_COMMANDNOP_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: NOOP command %s",
                       ROBOT_SIM_VERSION);
 
     return CFE_SUCCESS;
@@ -374,147 +764,1113 @@ int32 RobotSimNoop(const RobotSimNoopCmd_t *Msg)
 
 int32 RobotSimCmdJointState(const RobotSimJointStateCmd_t *Msg)
 {
-    RobotSimGoal.HkTlm.Payload.state.joint0 = Msg->joint0;
-    RobotSimGoal.HkTlm.Payload.state.joint1 = Msg->joint1; 
-    RobotSimGoal.HkTlm.Payload.state.joint2 = Msg->joint2;
-    RobotSimGoal.HkTlm.Payload.state.joint3 = Msg->joint3;
-    RobotSimGoal.HkTlm.Payload.state.joint4 = Msg->joint4;
-    RobotSimGoal.HkTlm.Payload.state.joint5 = Msg->joint5;
-    RobotSimGoal.HkTlm.Payload.state.joint6 = Msg->joint6;
-
-#if 0
-    OS_printf("\nGoal:\n---------------------\n");
-    OS_printf("joint0: %f\n", RobotSimGoal.HkTlm.Payload.state.joint0);
-    OS_printf("joint1: %f\n", RobotSimGoal.HkTlm.Payload.state.joint1);
-    OS_printf("joint2: %f\n", RobotSimGoal.HkTlm.Payload.state.joint2);
-    OS_printf("joint3: %f\n", RobotSimGoal.HkTlm.Payload.state.joint3);
-    OS_printf("joint4: %f\n", RobotSimGoal.HkTlm.Payload.state.joint4);
-    OS_printf("joint5: %f\n", RobotSimGoal.HkTlm.Payload.state.joint5);
-    OS_printf("joint6: %f\n", RobotSimGoal.HkTlm.Payload.state.joint6);
-#endif
-
-    CFE_EVS_SendEvent(ROBOT_SIM_COMMANDJNT_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: joint state command %s",
-                      ROBOT_SIM_VERSION);
+    RobotSimCtrlReq_t Req;
+    int32             status;
+
+    Req.Type         = ROBOT_SIM_REQ_SETPOINT;
+    Req.Data.Goal[0] = Msg->joint0;
+    Req.Data.Goal[1] = Msg->joint1;
+    Req.Data.Goal[2] = Msg->joint2;
+    Req.Data.Goal[3] = Msg->joint3;
+    Req.Data.Goal[4] = Msg->joint4;
+    Req.Data.Goal[5] = Msg->joint5;
+    Req.Data.Goal[6] = Msg->joint6;
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMANDJNT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "robot sim: joint state command %s", ROBOT_SIM_VERSION);
+    }
 
-    return CFE_SUCCESS;
+    return status;
     
 }
 
-void HighRateControLoop(void) {
-
-    // RobotSimData.square_counter++;
-    // if (RobotSimData.square_counter < 500)
-    // {
-    //     RobotSimGoal.HkTlm.Payload.state.joint3 = -1.0;//Msg->joint3;
-    // }
-    // else if (RobotSimData.square_counter < 1000)
-    // {
-    //     RobotSimGoal.HkTlm.Payload.state.joint3 = 1.0;//Msg->joint3;
-    // }
-    // else if (RobotSimData.square_counter == 1000)
-    // {
-    //     RobotSimData.square_counter = 0;   
-    // }
-
-    // if (RobotSimData.square_counter%100 == 0)
-    // {
-    //     OS_printf("counter: %d,  j: %f\n", (int)RobotSimData.square_counter, RobotSimGoal.HkTlm.Payload.state.joint3);
-    // }
-
-    // RobotSimTlmState_t *st = &StateMsg; //RobotSimGoal.StateTlm;
-    RobotSimTlmState_t *st = &StateMsg; //RobotSimGoal.StateTlm;
-
-    st->errors[0] = (RobotSimGoal.HkTlm.Payload.state.joint0 - RobotSimData.HkTlm.Payload.state.joint0);
-    st->errors[1] = (RobotSimGoal.HkTlm.Payload.state.joint1 - RobotSimData.HkTlm.Payload.state.joint1);
-    st->errors[2] = (RobotSimGoal.HkTlm.Payload.state.joint2 - RobotSimData.HkTlm.Payload.state.joint2);
-    st->errors[3] = (RobotSimGoal.HkTlm.Payload.state.joint3 - RobotSimData.HkTlm.Payload.state.joint3);
-    st->errors[4] = (RobotSimGoal.HkTlm.Payload.state.joint4 - RobotSimData.HkTlm.Payload.state.joint4);
-    st->errors[5] = (RobotSimGoal.HkTlm.Payload.state.joint5 - RobotSimData.HkTlm.Payload.state.joint5);
-    st->errors[6] = (RobotSimGoal.HkTlm.Payload.state.joint6 - RobotSimData.HkTlm.Payload.state.joint6);
-
-#if 0
-    OS_printf("\n---------------------\n");
-    OS_printf("---------------------\n");
-    OS_printf("---------------------\n");
-
-    OS_printf("\nCurrent:\n---------------------\n");
-    OS_printf("joint0: %f\n", RobotSimData.HkTlm.Payload.state.joint0);
-    OS_printf("joint1: %f\n", RobotSimData.HkTlm.Payload.state.joint1);
-    OS_printf("joint2: %f\n", RobotSimData.HkTlm.Payload.state.joint2);
-    OS_printf("joint3: %f\n", RobotSimData.HkTlm.Payload.state.joint3);
-    OS_printf("joint4: %f\n", RobotSimData.HkTlm.Payload.state.joint4);
-    OS_printf("joint5: %f\n", RobotSimData.HkTlm.Payload.state.joint5);
-    OS_printf("joint6: %f\n", RobotSimData.HkTlm.Payload.state.joint6);
-
-    OS_printf("\nError:\n---------------------\n");
-    OS_printf("joint0: %f\n", st->errors[0]);
-    OS_printf("joint1: %f\n", st->errors[1]);
-    OS_printf("joint2: %f\n", st->errors[2]);
-    OS_printf("joint3: %f\n", st->errors[3]);
-    OS_printf("joint4: %f\n", st->errors[4]);
-    OS_printf("joint5: %f\n", st->errors[5]);
-    OS_printf("joint6: %f\n", st->errors[6]);
-#endif
-    
-    RobotSimData.HkTlm.Payload.state.joint0 = RobotSimData.HkTlm.Payload.state.joint0 + Kp * st->errors[0];
-    RobotSimData.HkTlm.Payload.state.joint1 = RobotSimData.HkTlm.Payload.state.joint1 + Kp * st->errors[1];
-    RobotSimData.HkTlm.Payload.state.joint2 = RobotSimData.HkTlm.Payload.state.joint2 + Kp * st->errors[2];
-    RobotSimData.HkTlm.Payload.state.joint3 = RobotSimData.HkTlm.Payload.state.joint3 + Kp * st->errors[3];
-    RobotSimData.HkTlm.Payload.state.joint4 = RobotSimData.HkTlm.Payload.state.joint4 + Kp * st->errors[4];
-    RobotSimData.HkTlm.Payload.state.joint5 = RobotSimData.HkTlm.Payload.state.joint5 + Kp * st->errors[5];
-    RobotSimData.HkTlm.Payload.state.joint6 = RobotSimData.HkTlm.Payload.state.joint6 + Kp * st->errors[6];
-
-#if 0
-    printf("\nDesired:\n---------------------\n");
-    // printf("joint0: %f\n", RobotSimData.HkTlm.Payload.state.joint0);
-    // printf("joint1: %f\n", RobotSimData.HkTlm.Payload.state.joint1);
-    // printf("joint2: %f\n", RobotSimData.HkTlm.Payload.state.joint2);
-    printf("joint3: %f\n", RobotSimData.HkTlm.Payload.state.joint3);
-    // printf("joint4: %f\n", RobotSimData.HkTlm.Payload.state.joint4);
-    // printf("joint5: %f\n", RobotSimData.HkTlm.Payload.state.joint5);
-    // printf("joint6: %f\n", RobotSimData.HkTlm.Payload.state.joint6);
-#endif
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdSetKp -- change the proportional gain                           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdSetKp(const RobotSimSetKpCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int32             status;
 
-    // st->errors[3] = RobotSimGoal.HkTlm.Payload.state.joint3;
+    Req.Type    = ROBOT_SIM_REQ_GAIN;
+    Req.Data.Kp = Msg->Kp;
 
-    st->Kp = Kp;
-    memcpy(&st->joints, &RobotSimData.HkTlm.Payload.state, sizeof(RobotSimSSRMS_t) );
-    
-    // if (RobotSimData.square_counter%1000 == 0)
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
     {
-    CFE_SB_TimeStampMsg(&st->TlmHeader.Msg);
-    CFE_SB_TransmitMsg(&st->TlmHeader.Msg, true);
+        RobotSimSendEvent(ROBOT_SIM_COMMANDCTL_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: Kp set to %f",
+                          (double)Msg->Kp);
     }
+
+    return status;
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
 /*                                                                            */
-/* RobotSimVerifyCmdLength() -- Verify command packet length                   */
+/* RobotSimCmdSetMode -- change the control mode                              */
 /*                                                                            */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
-bool RobotSimVerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength)
+int32 RobotSimCmdSetMode(const RobotSimSetModeCmd_t *Msg)
 {
-    bool              result       = true;
-    size_t            ActualLength = 0;
-    CFE_SB_MsgId_t    MsgId        = CFE_SB_INVALID_MSG_ID;
-    CFE_MSG_FcnCode_t FcnCode      = 0;
+    RobotSimCtrlReq_t Req;
+    int32             status;
+
+    if (Msg->Mode != ROBOT_SIM_MODE_POSITION && Msg->Mode != ROBOT_SIM_MODE_HOLD &&
+        Msg->Mode != ROBOT_SIM_MODE_VELOCITY)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR, "robot sim: invalid mode %u",
+                          (unsigned int)Msg->Mode);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Req.Type      = ROBOT_SIM_REQ_MODE;
+    Req.Data.Mode = Msg->Mode;
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMANDCTL_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: mode set to %u",
+                          (unsigned int)Msg->Mode);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdStop -- halt the arm at its current position                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdStop(const RobotSimStopCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int32             status;
+
+    Req.Type = ROBOT_SIM_REQ_STOP;
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMANDCTL_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: stop");
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdSetSensor -- set the error model of one joint encoder           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdSetSensor(const RobotSimSetSensorCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int32             status;
+
+    if (Msg->Joint >= NUM_JOINTS || Msg->DelaySamples >= ROBOT_SIM_SENSOR_MAX_DELAY || !(Msg->NoiseStdDev >= 0.0f) ||
+        !(Msg->BiasDriftStdDev >= 0.0f) || !(Msg->Quantum >= 0.0f) || !(Msg->DropoutProb >= 0.0f) ||
+        !(Msg->DropoutProb <= 1.0f))
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: invalid sensor model for joint %u", (unsigned int)Msg->Joint);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Req.Type                        = ROBOT_SIM_REQ_SENSOR;
+    Req.Data.Sensor.Joint           = Msg->Joint;
+    Req.Data.Sensor.NoiseStdDev     = Msg->NoiseStdDev;
+    Req.Data.Sensor.BiasDriftStdDev = Msg->BiasDriftStdDev;
+    Req.Data.Sensor.Quantum         = Msg->Quantum;
+    Req.Data.Sensor.DropoutProb     = Msg->DropoutProb;
+    Req.Data.Sensor.DelaySamples    = Msg->DelaySamples;
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_SENSOR_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "robot sim: joint %u sensor noise %g drift %g quantum %g dropout %g delay %u",
+                          (unsigned int)Msg->Joint, (double)Msg->NoiseStdDev, (double)Msg->BiasDriftStdDev,
+                          (double)Msg->Quantum, (double)Msg->DropoutProb, (unsigned int)Msg->DelaySamples);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdSensorFault -- inject or clear a joint encoder fault            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdSensorFault(const RobotSimSensorFaultCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int32             status;
+
+    if (Msg->Joint >= NUM_JOINTS || Msg->Fault > ROBOT_SIM_SENSOR_FAULT_STUCK_AT)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: invalid sensor fault %u for joint %u", (unsigned int)Msg->Fault,
+                          (unsigned int)Msg->Joint);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Req.Type             = ROBOT_SIM_REQ_FAULT;
+    Req.Data.Fault.Joint = Msg->Joint;
+    Req.Data.Fault.Fault = Msg->Fault;
+    Req.Data.Fault.Value = Msg->Value;
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_SENSOR_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "robot sim: joint %u sensor fault set to %u", (unsigned int)Msg->Joint,
+                          (unsigned int)Msg->Fault);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdSensorSeed -- restart the sensor noise streams                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdSensorSeed(const RobotSimSensorSeedCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int32             status;
+
+    Req.Type      = ROBOT_SIM_REQ_SEED;
+    Req.Data.Seed = Msg->Seed;
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_SENSOR_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "robot sim: sensor seed set to 0x%08lX", (unsigned long)Msg->Seed);
+    }
+
+    return status;
+}
 
-    printf("RobotSimVerifyCmdLength() --\n");
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdRecTrigger -- mark an event in the state recording              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdRecTrigger(const RobotSimRecTriggerCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int32             status;
+
+    Req.Type                     = ROBOT_SIM_REQ_TRIGGER;
+    Req.Data.Trigger.PreSamples  = Msg->PreSamples;
+    Req.Data.Trigger.PostSamples = Msg->PostSamples;
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_REC_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "robot sim: recorder trigger, keeping %lu before and %lu after",
+                          (unsigned long)Msg->PreSamples, (unsigned long)Msg->PostSamples);
+    }
+
+    return status;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdRecFreeze -- stop or resume the state recording                 */
+/*                                                                            */
+/* Like a trigger, this takes effect at the start of the next HR tick, in    */
+/* order with the other recorder and control requests.                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdRecFreeze(const RobotSimRecFreezeCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+
+    Req.Type        = ROBOT_SIM_REQ_FREEZE;
+    Req.Data.Freeze = (Msg->Freeze != 0);
+
+    return RobotSimPostCtrlRequest(&Req);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdRecTrim -- narrow the window that will be dumped                */
+/*                                                                            */
+/* The recorder must be frozen by the time the HR loop applies the trim.     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdRecTrim(const RobotSimRecTrimCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+
+    Req.Type                     = ROBOT_SIM_REQ_TRIM;
+    Req.Data.Trigger.PreSamples  = Msg->PreSamples;
+    Req.Data.Trigger.PostSamples = Msg->PostSamples;
+
+    return RobotSimPostCtrlRequest(&Req);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdRecDump -- write the recorder window to a file                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdRecDump(const RobotSimRecDumpCmd_t *Msg)
+{
+    char   Filename[OS_MAX_PATH_LEN];
+    uint32 NumRecords;
+    int32  status;
+
+    strncpy(Filename, Msg->Filename, sizeof(Filename) - 1);
+    Filename[sizeof(Filename) - 1] = 0;
+
+    status = RobotSimRecDump(&RobotSimData.Recorder, Filename, &NumRecords);
+    if (status != CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_REC_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: recorder dump to %s failed, RC = 0x%08lX (%s)", Filename, (unsigned long)status,
+                          (status == CFE_STATUS_VALIDATION_FAILURE) ? "recorder must be frozen" : "file error");
+        RobotSimData.ErrCounter++;
+        return status;
+    }
+
+    RobotSimSendEvent(ROBOT_SIM_REC_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: %lu samples dumped to %s",
+                      (unsigned long)NumRecords, Filename);
+
+    return CFE_SUCCESS;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdSetTwist -- tool twist for velocity mode                        */
+/*                                                                            */
+/* Hand-controller input arrives at a high rate, so accepted twists are not   */
+/* announced with an event.                                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdSetTwist(const RobotSimSetTwistCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int               i;
+
+    for (i = 0; i < 6; i++)
+    {
+        if (!isfinite(Msg->Twist[i]))
+        {
+            RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "robot sim: invalid twist component %d", i);
+            RobotSimData.ErrCounter++;
+            return CFE_STATUS_VALIDATION_FAILURE;
+        }
+    }
+
+    Req.Type = ROBOT_SIM_REQ_TWIST;
+    memcpy(Req.Data.Twist, Msg->Twist, sizeof(Req.Data.Twist));
+
+    return RobotSimPostCtrlRequest(&Req);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdSetTrajectory -- goal with rate and acceleration feedforward    */
+/*                                                                            */
+/* Trajectory points are streamed at a high rate, so accepted points are not */
+/* announced with an event.                                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdSetTrajectory(const RobotSimSetTrajectoryCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int               i;
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        if (!isfinite(Msg->Position[i]) || !isfinite(Msg->Velocity[i]) || !isfinite(Msg->Acceleration[i]))
+        {
+            RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "robot sim: invalid trajectory point for joint %d", i);
+            RobotSimData.ErrCounter++;
+            return CFE_STATUS_VALIDATION_FAILURE;
+        }
+    }
+
+    Req.Type = ROBOT_SIM_REQ_TRAJECTORY;
+    memcpy(Req.Data.Trajectory.Goal, Msg->Position, sizeof(Req.Data.Trajectory.Goal));
+    memcpy(Req.Data.Trajectory.Rate, Msg->Velocity, sizeof(Req.Data.Trajectory.Rate));
+    memcpy(Req.Data.Trajectory.Accel, Msg->Acceleration, sizeof(Req.Data.Trajectory.Accel));
+
+    return RobotSimPostCtrlRequest(&Req);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdGrapple -- attach a payload to the tool frame                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdGrapple(const RobotSimGrappleCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    const float      *I = Msg->Inertia;
+    int32             status;
+
+    /*
+    ** Positive mass and finite principal moments that satisfy the triangle
+    ** inequality, as any real body does
+    */
+    if (!(Msg->Mass > 0.0f) || !isfinite(Msg->Mass) || !isfinite(Msg->Com[0]) || !isfinite(Msg->Com[1]) ||
+        !isfinite(Msg->Com[2]) || !isfinite(I[0]) || !isfinite(I[1]) || !isfinite(I[2]) || !(I[0] >= 0.0f) ||
+        !(I[1] >= 0.0f) || !(I[2] >= 0.0f) || !(I[0] + I[1] >= I[2]) || !(I[1] + I[2] >= I[0]) ||
+        !(I[0] + I[2] >= I[1]) || !isfinite(I[3]) || !isfinite(I[4]) || !isfinite(I[5]))
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: invalid payload, mass %g", (double)Msg->Mass);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Req.Type              = ROBOT_SIM_REQ_GRAPPLE;
+    Req.Data.Payload.Mass = Msg->Mass;
+    memcpy(Req.Data.Payload.Com, Msg->Com, sizeof(Req.Data.Payload.Com));
+    memcpy(Req.Data.Payload.Inertia, Msg->Inertia, sizeof(Req.Data.Payload.Inertia));
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMANDCTL_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "robot sim: grapple %g kg payload, CoM %g %g %g", (double)Msg->Mass, (double)Msg->Com[0],
+                          (double)Msg->Com[1], (double)Msg->Com[2]);
+    }
+
+    return status;
+
+} /* End of RobotSimCmdGrapple() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdRelease -- let go of the grappled payload                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdRelease(const RobotSimReleaseCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int32             status;
+
+    Req.Type = ROBOT_SIM_REQ_RELEASE;
+
+    status = RobotSimPostCtrlRequest(&Req);
+    if (status == CFE_SUCCESS)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMANDCTL_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: release");
+    }
+
+    return status;
+
+} /* End of RobotSimCmdRelease() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdDefineView -- define, redefine or delete a telemetry view       */
+/*                                                                            */
+/* Views belong to the HR loop, so the field list is only checked here, by    */
+/* compiling it into a scratch view, and the live view is replaced when the   */
+/* HR loop drains the request.                                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdDefineView(const RobotSimDefineViewCmd_t *Msg)
+{
+    static RobotSimView_t Scratch;
+    RobotSimCtrlReq_t     Req;
+    CFE_MSG_Size_t        Length;
+    bool                  Delete;
+
+    CFE_MSG_GetSize(&Msg->CmdHeader.Msg, &Length);
+
+    if (Msg->View >= ROBOT_SIM_MAX_VIEWS || Msg->NumFields > ROBOT_SIM_VIEW_MAX_FIELDS ||
+        offsetof(RobotSimDefineViewCmd_t, Fields) + Msg->NumFields > Length)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: invalid view %u with %u fields", (unsigned int)Msg->View,
+                          (unsigned int)Msg->NumFields);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Delete = Msg->RateDivisor == 0 || Msg->NumFields == 0;
+
+    if (!Delete && !CFE_SB_IsValidMsgId(CFE_SB_ValueToMsgId(Msg->MsgId)))
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: view %u has invalid MID 0x%x", (unsigned int)Msg->View,
+                          (unsigned int)Msg->MsgId);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    if (!RobotSimViewCompile(&Scratch, RobotSimData.ViewFields, Msg->Fields, Msg->NumFields, Msg->RateDivisor))
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: view %u has an unknown field or exceeds %u bytes", (unsigned int)Msg->View,
+                          (unsigned int)ROBOT_SIM_VIEW_MAX_BYTES);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    memset(&Req, 0, sizeof(Req));
+    Req.Type                  = ROBOT_SIM_REQ_VIEW;
+    Req.Data.View.View        = Msg->View;
+    Req.Data.View.NumFields   = Delete ? 0 : Msg->NumFields;
+    Req.Data.View.RateDivisor = Delete ? 0 : Msg->RateDivisor;
+    Req.Data.View.MsgId       = Msg->MsgId;
+    memcpy(Req.Data.View.Fields, Msg->Fields, Req.Data.View.NumFields);
+
+    return RobotSimPostCtrlRequest(&Req);
+
+} /* End of RobotSimCmdDefineView() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdSetPhysics -- select the physics backend                        */
+/*                                                                            */
+/* A co-simulation link is connected here, so a missing physics process is   */
+/* reported with the command, and handed over with the request. The HR loop  */
+/* synchronizes it and switches backends when it drains the request.         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdSetPhysics(const RobotSimSetPhysicsCmd_t *Msg)
+{
+    RobotSimCtrlReq_t Req;
+    int32             status;
+#ifdef ROBOT_SIM_COSIM_ENABLED
+    RobotSimCosim_t Link;
+    char            Path[OS_MAX_PATH_LEN];
+#endif
+
+    if (Msg->Backend >= ROBOT_SIM_PHYSICS_BACKENDS || RobotSimPhysicsBackends[Msg->Backend].Step == NULL)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: physics backend %u not available", (unsigned int)Msg->Backend);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Req.Type                 = ROBOT_SIM_REQ_PHYSICS;
+    Req.Data.Physics.Backend = Msg->Backend;
+    Req.Data.Physics.Fd      = -1;
+
+#ifdef ROBOT_SIM_COSIM_ENABLED
+    if (Msg->Backend == ROBOT_SIM_PHYSICS_COSIM)
+    {
+        strncpy(Path, Msg->SocketPath, sizeof(Path) - 1);
+        Path[sizeof(Path) - 1] = 0;
+        if (Path[0] == 0)
+        {
+            strncpy(Path, ROBOT_SIM_COSIM_PATH, sizeof(Path) - 1);
+        }
+
+        RobotSimCosimInit(&Link);
+        if (RobotSimCosimConnect(&Link, Path, ROBOT_SIM_PHYSICS_DT, ROBOT_SIM_COSIM_TIMEOUT_MSEC) !=
+            ROBOT_SIM_COSIM_OK)
+        {
+            RobotSimSendEvent(ROBOT_SIM_COSIM_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "robot sim: no physics process on %s, staying on current physics", Path);
+            RobotSimData.ErrCounter++;
+            return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+        }
+        Req.Data.Physics.Fd = Link.Fd;
+    }
+#endif
+
+    status = RobotSimPostCtrlRequest(&Req);
+
+#ifdef ROBOT_SIM_COSIM_ENABLED
+    if (status != CFE_SUCCESS && Req.Data.Physics.Fd >= 0)
+    {
+        RobotSimCosimClose(&Link);
+    }
+#endif
+
+    return status;
+
+} /* End of RobotSimCmdSetPhysics() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdSetEventMode -- count command confirmations instead of sending  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimCmdSetEventMode(const RobotSimSetEventModeCmd_t *Msg)
+{
+    RobotSimData.EvLim.Quiet = (Msg->Quiet != 0);
+
+    /*
+    ** Not budgeted, so entering quiet mode is always confirmed
+    */
+    CFE_EVS_SendEvent(ROBOT_SIM_EVENT_SUMMARY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                      "robot sim: quiet mode %s, %lu confirmations counted so far",
+                      RobotSimData.EvLim.Quiet ? "on" : "off", (unsigned long)RobotSimData.EvLim.QuietTotal);
+
+    return CFE_SUCCESS;
+
+} /* End of RobotSimCmdSetEventMode() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSendEvent() -- CFE_EVS_SendEvent() within the event's budget       */
+/*                                                                            */
+/* An event over budget costs a table lookup; it is neither formatted nor    */
+/* handed to EVS.                                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimSendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+    char    Text[CFE_MISSION_EVS_MAX_MESSAGE_LENGTH];
+    va_list Args;
+
+    if (!RobotSimEvLimTake(&RobotSimData.EvLim, EventID))
+    {
+        return CFE_SUCCESS;
+    }
+
+    va_start(Args, Spec);
+    vsnprintf(Text, sizeof(Text), Spec, Args);
+    va_end(Args);
+
+    return CFE_EVS_SendEvent(EventID, EventType, "%s", Text);
+
+} /* End of RobotSimSendEvent() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimEventSummary() -- report suppressed events, then refill budgets    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimEventSummary(void)
+{
+    RobotSimEvLimBucket_t *Bucket;
+    uint16                 i;
+
+    for (i = 0; i < RobotSimData.EvLim.NumBuckets; i++)
+    {
+        Bucket = &RobotSimData.EvLim.Bucket[i];
+        if (Bucket->SuppressedCount != 0)
+        {
+            CFE_EVS_SendEvent(ROBOT_SIM_EVENT_SUMMARY_INF_EID, CFE_EVS_EventType_INFORMATION,
+                              "robot sim: %lu events with ID %u suppressed, budget %u per HK",
+                              (unsigned long)Bucket->SuppressedCount, (unsigned int)Bucket->EventID,
+                              (unsigned int)Bucket->Rate);
+            Bucket->SuppressedCount = 0;
+        }
+    }
+
+    RobotSimEvLimRefill(&RobotSimData.EvLim);
+
+} /* End of RobotSimEventSummary() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimPostCtrlRequest() -- hand a control request to the HR loop         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimPostCtrlRequest(const RobotSimCtrlReq_t *Req)
+{
+    if (!RobotSimCmdQueuePush(&RobotSimData.CtrlQueue, Req))
+    {
+        RobotSimSendEvent(ROBOT_SIM_CTRL_QUEUE_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: control queue full, request type %u dropped", (unsigned int)Req->Type);
+        RobotSimData.ErrCounter++;
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    return CFE_SUCCESS;
+
+} /* End of RobotSimPostCtrlRequest() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimDrainCtrlRequests() -- apply queued requests, in order             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimDrainCtrlRequests(void)
+{
+    static const float Zero[6] = {0.0f};
+    RobotSimCtrlReq_t  Req;
+    uint32             Joint;
+    float              Rate[NUM_JOINTS];
+    float              Accel[NUM_JOINTS];
+    RobotSimPayload_t  Payload;
+
+    while (RobotSimCmdQueuePop(&RobotSimData.CtrlQueue, &Req))
+    {
+        switch (Req.Type)
+        {
+            case ROBOT_SIM_REQ_SETPOINT:
+                RobotSimModelSetGoal(&RobotSimData.Model, Req.Data.Goal);
+                break;
+
+            case ROBOT_SIM_REQ_GAIN:
+                RobotSimModelSetKp(&RobotSimData.Model, Req.Data.Kp);
+                break;
+
+            case ROBOT_SIM_REQ_MODE:
+                /*
+                ** A twist left over from an earlier velocity session must
+                ** not move the arm the moment velocity mode is re-entered
+                */
+                if (Req.Data.Mode == ROBOT_SIM_MODE_VELOCITY && RobotSimData.Model.Mode != ROBOT_SIM_MODE_VELOCITY)
+                {
+                    RobotSimVelSetTwist(&RobotSimData.Vel, Zero);
+                }
+                RobotSimData.Model.Mode = (int)Req.Data.Mode;
+                break;
+
+            case ROBOT_SIM_REQ_STOP:
+                RobotSimModelStop(&RobotSimData.Model);
+                RobotSimVelSetTwist(&RobotSimData.Vel, Zero);
+                break;
+
+            case ROBOT_SIM_REQ_SENSOR:
+                Joint = Req.Data.Sensor.Joint;
+
+                RobotSimData.Sensor.Config.NoiseStdDev[Joint]     = Req.Data.Sensor.NoiseStdDev;
+                RobotSimData.Sensor.Config.BiasDriftStdDev[Joint] = Req.Data.Sensor.BiasDriftStdDev;
+                RobotSimData.Sensor.Config.Quantum[Joint]         = Req.Data.Sensor.Quantum;
+                RobotSimData.Sensor.Config.DropoutProb[Joint]     = Req.Data.Sensor.DropoutProb;
+                RobotSimData.Sensor.Config.DelaySamples[Joint]    = Req.Data.Sensor.DelaySamples;
+                break;
+
+            case ROBOT_SIM_REQ_FAULT:
+                RobotSimSensorSetFault(&RobotSimData.Sensor, Req.Data.Fault.Joint, Req.Data.Fault.Fault,
+                                       Req.Data.Fault.Value);
+                break;
+
+            case ROBOT_SIM_REQ_SEED:
+                RobotSimSensorSeed(&RobotSimData.Sensor, Req.Data.Seed);
+                break;
+
+            case ROBOT_SIM_REQ_TRIGGER:
+                RobotSimRecTrigger(&RobotSimData.Recorder, Req.Data.Trigger.PreSamples,
+                                   Req.Data.Trigger.PostSamples);
+                break;
+
+            case ROBOT_SIM_REQ_FREEZE:
+                RobotSimRecFreeze(&RobotSimData.Recorder, Req.Data.Freeze != 0);
+
+                RobotSimSendEvent(ROBOT_SIM_REC_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                  "robot sim: recorder %s at sample %lu", (Req.Data.Freeze != 0) ? "frozen" : "resumed",
+                                  (unsigned long)RobotSimData.Recorder.Head);
+                break;
+
+            case ROBOT_SIM_REQ_TRIM:
+                if (RobotSimRecTrim(&RobotSimData.Recorder, Req.Data.Trigger.PreSamples,
+                                    Req.Data.Trigger.PostSamples) != CFE_SUCCESS)
+                {
+                    RobotSimSendEvent(ROBOT_SIM_REC_ERR_EID, CFE_EVS_EventType_ERROR,
+                                      "robot sim: recorder must be frozen before trim");
+                    RobotSimData.ErrCounter++;
+                    break;
+                }
+
+                RobotSimSendEvent(ROBOT_SIM_REC_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                  "robot sim: recorder window trimmed to samples %lu-%lu",
+                                  (unsigned long)RobotSimData.Recorder.WindowStart,
+                                  (unsigned long)RobotSimData.Recorder.WindowEnd);
+                break;
+
+            case ROBOT_SIM_REQ_TWIST:
+                RobotSimVelSetTwist(&RobotSimData.Vel, Req.Data.Twist);
+                break;
+
+            case ROBOT_SIM_REQ_TRAJECTORY:
+                for (Joint = 0; Joint < NUM_JOINTS; Joint++)
+                {
+                    Rate[Joint]  = Req.Data.Trajectory.Rate[Joint] * ROBOT_SIM_PHYSICS_DT;
+                    Accel[Joint] = Req.Data.Trajectory.Accel[Joint] * ROBOT_SIM_PHYSICS_DT * ROBOT_SIM_PHYSICS_DT;
+                }
+                RobotSimModelSetTrajectory(&RobotSimData.Model, Req.Data.Trajectory.Goal, Rate, Accel);
+                break;
+
+            case ROBOT_SIM_REQ_GRAPPLE:
+                Payload.Mass = Req.Data.Payload.Mass;
+                memcpy(Payload.Com, Req.Data.Payload.Com, sizeof(Payload.Com));
+                memcpy(Payload.Inertia, Req.Data.Payload.Inertia, sizeof(Payload.Inertia));
+                RobotSimDynGrapple(&RobotSimData.Dyn, &Payload);
+                break;
+
+            case ROBOT_SIM_REQ_RELEASE:
+                RobotSimDynRelease(&RobotSimData.Dyn);
+                break;
+
+            case ROBOT_SIM_REQ_VIEW:
+                RobotSimViewDefine(&Req);
+                break;
+
+            case ROBOT_SIM_REQ_PHYSICS:
+                RobotSimPhysicsSelect(&Req);
+                break;
+
+            default:
+                break;
+        }
+    }
+
+} /* End of RobotSimDrainCtrlRequests() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* HighRateControLoop() -- HR wakeup, runs the stages due on this tick         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void HighRateControLoop(void)
+{
+    RobotSimDrainCtrlRequests();
+
+    RobotSimSchedTick(&RobotSimData.Sched);
+}
+
+/*
+** The control law and physics live in the model core so the batch tool
+** runs exactly the same step as the flight app
+*/
+int32 RobotSimInternalPhysics(void)
+{
+    RobotSimModelPhysics(&RobotSimData.Model);
+
+    return CFE_SUCCESS;
+}
+
+#ifdef ROBOT_SIM_COSIM_ENABLED
+/*
+** Lockstep with an external process. The predicted torques are those of
+** the previous tick, the last ones the dynamics have seen. A link that
+** fails is dropped.
+*/
+int32 RobotSimCosimPhysics(void)
+{
+    int32 status;
+
+    status = RobotSimCosimStep(&RobotSimData.Cosim, &RobotSimData.Model, RobotSimData.Dyn.Torque);
+    if (status != ROBOT_SIM_COSIM_OK)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COSIM_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: physics process %s after %lu steps, falling back to internal physics",
+                          status == ROBOT_SIM_COSIM_TIMEOUT ? "timed out" : "failed",
+                          (unsigned long)RobotSimData.Cosim.StepCount);
+        RobotSimData.CosimFailCount++;
+        RobotSimCosimClose(&RobotSimData.Cosim);
+        return CFE_STATUS_EXTERNAL_RESOURCE_FAIL;
+    }
+
+    return CFE_SUCCESS;
+}
+#endif
+
+void RobotSimPhysicsStage(void)
+{
+    float Rate[NUM_JOINTS];
+    float Accel[NUM_JOINTS];
+    float AccelLimit[NUM_JOINTS];
+    int   i;
+
+    /*
+    ** A tick the external process missed is run internally, and the arm
+    ** stays on internal physics until commanded back
+    */
+    if (RobotSimData.Physics->Step() != CFE_SUCCESS)
+    {
+        RobotSimData.Physics = &RobotSimPhysicsBackends[ROBOT_SIM_PHYSICS_INTERNAL];
+        RobotSimData.Physics->Step();
+    }
+
+    RobotSimKinSetJoints(&RobotSimData.Kin, RobotSimData.Model.Position);
+
+    /*
+    ** Torques for the motion just made; the inertias they see, payload
+    ** included, bound how fast the drives can change rate next tick
+    */
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Rate[i]  = RobotSimData.Model.Applied[i] / ROBOT_SIM_PHYSICS_DT;
+        Accel[i] = RobotSimData.Model.AppliedChange[i] / (ROBOT_SIM_PHYSICS_DT * ROBOT_SIM_PHYSICS_DT);
+    }
+
+    RobotSimDynUpdate(&RobotSimData.Dyn, &RobotSimData.Kin, Rate, Accel);
+
+    RobotSimDynAccelLimit(&RobotSimData.Dyn, ROBOT_SIM_PHYSICS_DT, AccelLimit);
+    RobotSimModelSetAccelLimit(&RobotSimData.Model, AccelLimit);
+}
+
+void RobotSimControlStage(void)
+{
+    float Increment[NUM_JOINTS];
+    int   i;
+
+    if (RobotSimData.Model.Mode == ROBOT_SIM_MODE_VELOCITY)
+    {
+        RobotSimVelSolve(&RobotSimData.Vel, &RobotSimData.Kin);
+
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Increment[i] = RobotSimData.Vel.Rate[i] * ROBOT_SIM_PHYSICS_DT;
+        }
+        RobotSimModelSetRate(&RobotSimData.Model, Increment);
+    }
+
+    RobotSimModelControl(&RobotSimData.Model);
+}
+
+void RobotSimStateTlmStage(void)
+{
+    RobotSimTlmState_t    *st = &StateMsg;
+    const RobotSimXform_t *Tool;
+
+    memcpy(&st->pid, &RobotSimData.Model.Terms, sizeof(st->pid));
+    memcpy(st->errors, RobotSimData.Model.Error, sizeof(st->errors));
+
+    /*
+    ** Published joints are what the encoders report, not the true state
+    */
+    RobotSimSensorSample(&RobotSimData.Sensor, RobotSimData.Model.Position, (float *)&st->joints);
+
+    Tool = RobotSimKinGetFrame(&RobotSimData.Kin, ROBOT_SIM_KIN_TOOL);
+    memcpy(st->tool, Tool->p, sizeof(st->tool));
+
+    memcpy(st->torque, RobotSimData.Dyn.Torque, sizeof(st->torque));
+    memcpy(st->load, RobotSimData.Dyn.Load, sizeof(st->load));
+
+    CFE_SB_TimeStampMsg(&st->TlmHeader.Msg);
+    CFE_SB_TransmitMsg(&st->TlmHeader.Msg, true);
+}
+
+void RobotSimRecorderStage(void)
+{
+    RobotSimRecAppend(&RobotSimData.Recorder, &RobotSimData.Model);
+}
+
+void RobotSimViewStage(void)
+{
+    RobotSimView_t    *View;
+    RobotSimViewPkt_t *Pkt;
+    uint32             i;
+
+    for (i = 0; i < ROBOT_SIM_MAX_VIEWS; i++)
+    {
+        View = &RobotSimData.Views[i];
+        if (!RobotSimViewDue(View))
+        {
+            continue;
+        }
+
+        /*
+        ** The tool frame is the only source that is computed on demand
+        */
+        if (View->FieldMask & (1u << ROBOT_SIM_VIEW_FIELD_POSE))
+        {
+            RobotSimKinGetFrame(&RobotSimData.Kin, ROBOT_SIM_KIN_TOOL);
+        }
+
+        Pkt = &RobotSimData.ViewPkts[i];
+        RobotSimViewPack(View, Pkt->Data);
+
+        CFE_SB_TimeStampMsg(&Pkt->TlmHeader.Msg);
+        CFE_SB_TransmitMsg(&Pkt->TlmHeader.Msg, true);
+        RobotSimData.ViewPacketCount++;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimViewsInit() -- no views defined, and where each field lives       */
+/*                                                                            */
+/* Measured joints are the sample last published in the state packet, so a   */
+/* view never draws extra samples from the encoder model.                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimViewsInit(void)
+{
+    RobotSimViewField_t *Fields = RobotSimData.ViewFields;
+    RobotSimViewField_t *Timing;
+    uint32               i;
+
+    for (i = 0; i < ROBOT_SIM_MAX_VIEWS; i++)
+    {
+        RobotSimViewInit(&RobotSimData.Views[i]);
+    }
+
+    memset(RobotSimData.ViewFields, 0, sizeof(RobotSimData.ViewFields));
+
+#define ROBOT_SIM_VIEW_SOURCE(Id, Var)                  \
+    do                                                  \
+    {                                                   \
+        Fields[Id].NumSegments       = 1;               \
+        Fields[Id].Segment[0].Src    = &(Var);          \
+        Fields[Id].Segment[0].Length = sizeof(Var);     \
+    } while (0)
+
+    ROBOT_SIM_VIEW_SOURCE(ROBOT_SIM_VIEW_FIELD_JOINTS, StateMsg.joints);
+    ROBOT_SIM_VIEW_SOURCE(ROBOT_SIM_VIEW_FIELD_POSITION, RobotSimData.Model.Position);
+    ROBOT_SIM_VIEW_SOURCE(ROBOT_SIM_VIEW_FIELD_GOALS, RobotSimData.Model.Goal);
+    ROBOT_SIM_VIEW_SOURCE(ROBOT_SIM_VIEW_FIELD_ERRORS, RobotSimData.Model.Error);
+    ROBOT_SIM_VIEW_SOURCE(ROBOT_SIM_VIEW_FIELD_TORQUE, RobotSimData.Dyn.Torque);
+    ROBOT_SIM_VIEW_SOURCE(ROBOT_SIM_VIEW_FIELD_POSE, RobotSimData.Kin.Frame[ROBOT_SIM_KIN_TOOL]);
+
+#undef ROBOT_SIM_VIEW_SOURCE
+
+    Timing                       = &Fields[ROBOT_SIM_VIEW_FIELD_TIMING];
+    Timing->Segment[0].Src       = &RobotSimData.Sched.Tick;
+    Timing->Segment[0].Length    = sizeof(RobotSimData.Sched.Tick);
+    for (i = 0; i < RobotSimData.Sched.NumGroups; i++)
+    {
+        Timing->Segment[i + 1].Src    = &RobotSimData.Sched.Groups[i].Stats;
+        Timing->Segment[i + 1].Length = sizeof(RobotSimData.Sched.Groups[i].Stats);
+    }
+    Timing->NumSegments = RobotSimData.Sched.NumGroups + 1;
+
+} /* End of RobotSimViewsInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimViewDefine() -- replace a live view from a drained request         */
+/*                                                                            */
+/* The command handler has already checked the request against the field      */
+/* catalog; what is left depends on the other live views.                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimViewDefine(const RobotSimCtrlReq_t *Req)
+{
+    RobotSimView_t *View  = &RobotSimData.Views[Req->Data.View.View];
+    CFE_SB_MsgId_t  MsgId = CFE_SB_ValueToMsgId(Req->Data.View.MsgId);
+    CFE_SB_MsgId_t  OtherId;
+    uint32          i;
+
+    /*
+    ** Consumers tell views apart by MID only
+    */
+    for (i = 0; i < ROBOT_SIM_MAX_VIEWS && Req->Data.View.NumFields != 0; i++)
+    {
+        if (i != Req->Data.View.View && RobotSimData.Views[i].RateDivisor != 0)
+        {
+            CFE_MSG_GetMsgId(&RobotSimData.ViewPkts[i].TlmHeader.Msg, &OtherId);
+            if (CFE_SB_MsgId_Equal(OtherId, MsgId))
+            {
+                RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                                  "robot sim: view %u MID 0x%x already used by view %u",
+                                  (unsigned int)Req->Data.View.View, (unsigned int)Req->Data.View.MsgId,
+                                  (unsigned int)i);
+                RobotSimData.ErrCounter++;
+                return;
+            }
+        }
+    }
+
+    if (!RobotSimViewCompile(View, RobotSimData.ViewFields, Req->Data.View.Fields, Req->Data.View.NumFields,
+                             (uint16)Req->Data.View.RateDivisor))
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMAND_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "robot sim: view %u has an unknown field or exceeds %u bytes",
+                          (unsigned int)Req->Data.View.View, (unsigned int)ROBOT_SIM_VIEW_MAX_BYTES);
+        RobotSimData.ErrCounter++;
+        return;
+    }
+
+    if (Req->Data.View.NumFields == 0)
+    {
+        RobotSimSendEvent(ROBOT_SIM_COMMANDCTL_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "robot sim: view %u deleted", (unsigned int)Req->Data.View.View);
+    }
+    else
+    {
+        CFE_MSG_Init(&RobotSimData.ViewPkts[Req->Data.View.View].TlmHeader.Msg, MsgId,
+                     offsetof(RobotSimViewPkt_t, Data) + View->Size);
+
+        RobotSimSendEvent(ROBOT_SIM_COMMANDCTL_INF_EID, CFE_EVS_EventType_INFORMATION,
+                          "robot sim: view %u on MID 0x%x every %u ticks, %u bytes in %u copies",
+                          (unsigned int)Req->Data.View.View, (unsigned int)Req->Data.View.MsgId,
+                          (unsigned int)View->RateDivisor, (unsigned int)View->Size, (unsigned int)View->NumCopies);
+    }
+
+} /* End of RobotSimViewDefine() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimPhysicsSelect() -- switch backends from a drained request          */
+/*                                                                            */
+/* A new co-simulation link replaces any earlier one and starts from the     */
+/* current arm state; if the peer does not answer the sync the arm stays on  */
+/* internal physics.                                                         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimPhysicsSelect(const RobotSimCtrlReq_t *Req)
+{
+#ifdef ROBOT_SIM_COSIM_ENABLED
+    int32 status;
+
+    RobotSimCosimClose(&RobotSimData.Cosim);
+
+    if (Req->Data.Physics.Backend == ROBOT_SIM_PHYSICS_COSIM)
+    {
+        RobotSimCosimAttach(&RobotSimData.Cosim, Req->Data.Physics.Fd, ROBOT_SIM_PHYSICS_DT,
+                            ROBOT_SIM_COSIM_TIMEOUT_MSEC);
+
+        status = RobotSimCosimSync(&RobotSimData.Cosim, &RobotSimData.Model);
+        if (status != ROBOT_SIM_COSIM_OK)
+        {
+            RobotSimCosimClose(&RobotSimData.Cosim);
+            RobotSimData.Physics = &RobotSimPhysicsBackends[ROBOT_SIM_PHYSICS_INTERNAL];
+
+            RobotSimSendEvent(ROBOT_SIM_COSIM_ERR_EID, CFE_EVS_EventType_ERROR,
+                              "robot sim: physics process %s on sync, staying on internal physics",
+                              status == ROBOT_SIM_COSIM_TIMEOUT ? "timed out" : "failed");
+            RobotSimData.ErrCounter++;
+            return;
+        }
+    }
+#endif
+
+    RobotSimData.Physics = &RobotSimPhysicsBackends[Req->Data.Physics.Backend];
+
+    RobotSimSendEvent(ROBOT_SIM_COMMANDCTL_INF_EID, CFE_EVS_EventType_INFORMATION, "robot sim: %s physics",
+                      RobotSimData.Physics->Name);
+
+} /* End of RobotSimPhysicsSelect() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimVerifyCmdLength() -- Verify command packet length                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RobotSimVerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t MinLength, size_t MaxLength)
+{
+    bool              result       = true;
+    size_t            ActualLength = 0;
+    CFE_SB_MsgId_t    MsgId        = CFE_SB_INVALID_MSG_ID;
+    CFE_MSG_FcnCode_t FcnCode      = 0;
 
     CFE_MSG_GetSize(MsgPtr, &ActualLength);
 
     /*
     ** Verify the command packet length.
     */
-    if (ExpectedLength != ActualLength)
+    if (ActualLength < MinLength || ActualLength > MaxLength)
     {
         CFE_MSG_GetMsgId(MsgPtr, &MsgId);
         CFE_MSG_GetFcnCode(MsgPtr, &FcnCode);
 
-        CFE_EVS_SendEvent(ROBOT_SIM_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
-                          "Invalid Msg length: ID = 0x%X,  CC = %u, Len = %u, Expected = %u",
+        RobotSimSendEvent(ROBOT_SIM_LEN_ERR_EID, CFE_EVS_EventType_ERROR,
+                          "Invalid Msg length: ID = 0x%X,  CC = %u, Len = %u, Expected = %u to %u",
                           (unsigned int)CFE_SB_MsgIdToValue(MsgId), (unsigned int)FcnCode, (unsigned int)ActualLength,
-                          (unsigned int)ExpectedLength);
+                          (unsigned int)MinLength, (unsigned int)MaxLength);
 
         result = false;
 
@@ -41,6 +41,17 @@
 #include "robot_sim_perfids.h"
 #include "robot_sim_msgids.h"
 #include "robot_sim_msg.h"
+#include "robot_sim_model.h"
+#include "robot_sim_sched.h"
+#include "robot_sim_cmdq.h"
+#include "robot_sim_sensor.h"
+#include "robot_sim_rec.h"
+#include "robot_sim_kin.h"
+#include "robot_sim_vel.h"
+#include "robot_sim_dyn.h"
+#include "robot_sim_view.h"
+#include "robot_sim_cosim.h"
+#include "robot_sim_evlim.h"
 
 // #include "ros_app_msgids.h"
 
@@ -50,26 +61,135 @@
 ** Type Definitions
 *************************************************************************/
 
+/*
+** Dispatch entry point of a ground command, passes the buffer on to its
+** handler as the handler's own message type
+*/
+typedef int32 (*RobotSimCmdHandler_t)(const CFE_SB_Buffer_t *SBBufPtr);
+
+/*
+** Dispatch table entry, indexed by command code
+*/
+typedef struct
+{
+    RobotSimCmdHandler_t Handler; /**< NULL if the code is not used */
+    size_t               MinLength;
+    size_t               MaxLength; /**< Equal to MinLength for fixed-size commands */
+} RobotSimCmdEntry_t;
+
+/*
+** Physics backend, advances the arm one physics tick
+*/
+typedef struct
+{
+    const char *Name;
+    int32 (*Step)(void);
+} RobotSimPhysicsBackend_t;
+
 /*
 ** Global Data
 */
 
+/*
+** The state the HR loop touches every tick comes first, starting on a
+** cache line, so it packs into as few lines as possible. Configuration,
+** telemetry buffers and bulk history follow from the next line on.
+*/
+#define ROBOT_SIM_CACHE_ALIGNED __attribute__((aligned(ROBOT_SIM_CACHE_LINE)))
+
 typedef struct
 {
+    /*
+    ** Arm state, goals, gains and controller terms
+    */
+    RobotSimModel_t Model ROBOT_SIM_CACHE_ALIGNED;
+
+    /*
+    ** World transforms of every link, recomputed lazily after joints move
+    */
+    RobotSimKin_t Kin;
+
+    /*
+    ** Rigid-body dynamics and the grappled payload
+    */
+    RobotSimDyn_t Dyn;
+
+    /*
+    ** Encoder model between the sim state and the state telemetry
+    */
+    RobotSimSensor_t Sensor;
+
+    /*
+    ** HR rate groups (physics, control, state telemetry, recorder, views)
+    */
+    RobotSimSched_t Sched;
+
+    /*
+    ** Physics backend in use, and the link to an external one
+    */
+    const RobotSimPhysicsBackend_t *Physics;
+    RobotSimCosim_t                 Cosim;
+
+    /*
+    ** Resolved-rate solver, only stepped in velocity mode
+    */
+    RobotSimVel_t Vel;
+
+    /*
+    ** Control requests from command handling, drained at the start of each
+    ** HR tick. Only the indices are read on a tick without requests.
+    */
+    RobotSimCmdQueue_t CtrlQueue;
+
+    /*
+    ** End of the hot block
+    */
+
+    /*
+    ** Housekeeping telemetry packet...
+    */
+    RobotSimHkTlm_t HkTlm ROBOT_SIM_CACHE_ALIGNED;
+
     /*
     ** Command interface counters...
     */
     uint8 CmdCounter;
     uint8 ErrCounter;
 
+    RobotSimCmdStatsTlm_t CmdStats[ROBOT_SIM_NUM_CMD_CODES];
+
     uint32 square_counter;
     uint32 hk_counter;
+
+    double angle;
+
+    uint32 CosimFailCount;
+
     /*
-    ** Housekeeping telemetry packet...
+    ** Event budgets from the table and the quiet mode
     */
-    RobotSimHkTlm_t HkTlm;
+    RobotSimEvLim_t EvLim;
 
-    double angle;
+    /*
+    ** Telemetry views and where their fields live
+    */
+    RobotSimViewField_t ViewFields[ROBOT_SIM_VIEW_FIELD_COUNT];
+    RobotSimView_t      Views[ROBOT_SIM_MAX_VIEWS];
+    RobotSimViewPkt_t   ViewPkts[ROBOT_SIM_MAX_VIEWS];
+    uint32              ViewPacketCount;
+
+    /*
+    ** History of every HR sample, survives telemetry outages
+    */
+    RobotSimRec_t Recorder;
+
+    /*
+    ** Kinematic model table, held between housekeeping requests
+    */
+    CFE_TBL_Handle_t       TblHandle;
+    const RobotSimTable_t *TblPtr;
+    uint32                 TblLoadTimeUsec;
+    uint32                 TblUpdateCount;
 
     /*
     ** Run Status variable used in the main processing loop
@@ -107,10 +227,51 @@ void  RobotSimProcessGroundCommand(CFE_SB_Buffer_t *SBBufPtr);
 
 int32 RobotSimReportHousekeeping(const CFE_MSG_CommandHeader_t *Msg);
 
+int32 RobotSimTblInit(void);
+int32 RobotSimTblValidate(void *TblData);
+void  RobotSimTblApply(const RobotSimTable_t *Tbl);
+void  RobotSimTblManage(void);
+
 int32 RobotSimNoop(const RobotSimNoopCmd_t *Msg);
 int32 RobotSimCmdJointState(const RobotSimJointStateCmd_t *Msg);
+int32 RobotSimCmdSetKp(const RobotSimSetKpCmd_t *Msg);
+int32 RobotSimCmdSetMode(const RobotSimSetModeCmd_t *Msg);
+int32 RobotSimCmdStop(const RobotSimStopCmd_t *Msg);
+int32 RobotSimCmdSetSensor(const RobotSimSetSensorCmd_t *Msg);
+int32 RobotSimCmdSensorFault(const RobotSimSensorFaultCmd_t *Msg);
+int32 RobotSimCmdSensorSeed(const RobotSimSensorSeedCmd_t *Msg);
+int32 RobotSimCmdRecTrigger(const RobotSimRecTriggerCmd_t *Msg);
+int32 RobotSimCmdRecFreeze(const RobotSimRecFreezeCmd_t *Msg);
+int32 RobotSimCmdRecTrim(const RobotSimRecTrimCmd_t *Msg);
+int32 RobotSimCmdRecDump(const RobotSimRecDumpCmd_t *Msg);
+int32 RobotSimCmdSetTwist(const RobotSimSetTwistCmd_t *Msg);
+int32 RobotSimCmdSetTrajectory(const RobotSimSetTrajectoryCmd_t *Msg);
+int32 RobotSimCmdGrapple(const RobotSimGrappleCmd_t *Msg);
+int32 RobotSimCmdRelease(const RobotSimReleaseCmd_t *Msg);
+int32 RobotSimCmdDefineView(const RobotSimDefineViewCmd_t *Msg);
+int32 RobotSimCmdSetPhysics(const RobotSimSetPhysicsCmd_t *Msg);
+int32 RobotSimCmdSetEventMode(const RobotSimSetEventModeCmd_t *Msg);
+
+int32 RobotSimSendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...) OS_PRINTF(3, 4);
+void  RobotSimEventSummary(void);
+
+void  RobotSimViewsInit(void);
+void  RobotSimViewDefine(const RobotSimCtrlReq_t *Req);
+void  RobotSimPhysicsSelect(const RobotSimCtrlReq_t *Req);
+
+int32 RobotSimPostCtrlRequest(const RobotSimCtrlReq_t *Req);
+void  RobotSimDrainCtrlRequests(void);
+
+void HighRateControLoop(void);
+int32 RobotSimInternalPhysics(void);
+int32 RobotSimCosimPhysics(void);
+void RobotSimPhysicsStage(void);
+void RobotSimControlStage(void);
+void RobotSimStateTlmStage(void);
+void RobotSimRecorderStage(void);
+void RobotSimViewStage(void);
 
-bool RobotSimVerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t ExpectedLength);
+bool RobotSimVerifyCmdLength(CFE_MSG_Message_t *MsgPtr, size_t MinLength, size_t MaxLength);
 
 
 #endif /* _robot_sim_h_ */
@@ -0,0 +1,102 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_cmdq.c
+**
+** Purpose:
+**   This file contains the control request queue of the robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_cmdq.h"
+
+#include <string.h>
+
+/*
+** Head and Tail run freely and are masked on access
+*/
+typedef char RobotSimCmdQueueDepthCheck[((ROBOT_SIM_CTRL_QUEUE_DEPTH & (ROBOT_SIM_CTRL_QUEUE_DEPTH - 1)) == 0) ? 1 : -1];
+
+#define ROBOT_SIM_CTRL_QUEUE_MASK (ROBOT_SIM_CTRL_QUEUE_DEPTH - 1)
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdQueueInit() -- empty the queue and clear its counters           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimCmdQueueInit(RobotSimCmdQueue_t *Queue)
+{
+    memset(Queue, 0, sizeof(*Queue));
+
+} /* End of RobotSimCmdQueueInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdQueuePush() -- producer side, false if the queue is full        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RobotSimCmdQueuePush(RobotSimCmdQueue_t *Queue, const RobotSimCtrlReq_t *Req)
+{
+    uint32_t Tail = Queue->Tail;
+    uint32_t Head = __atomic_load_n(&Queue->Head, __ATOMIC_ACQUIRE);
+    uint32_t Depth = Tail - Head;
+
+    if (Depth >= ROBOT_SIM_CTRL_QUEUE_DEPTH)
+    {
+        Queue->OverflowCount++;
+        return false;
+    }
+
+    Queue->Slots[Tail & ROBOT_SIM_CTRL_QUEUE_MASK] = *Req;
+    __atomic_store_n(&Queue->Tail, Tail + 1, __ATOMIC_RELEASE);
+
+    if (Depth + 1 > Queue->HighWater)
+    {
+        Queue->HighWater = Depth + 1;
+    }
+
+    return true;
+
+} /* End of RobotSimCmdQueuePush() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCmdQueuePop() -- consumer side, false if the queue is empty        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RobotSimCmdQueuePop(RobotSimCmdQueue_t *Queue, RobotSimCtrlReq_t *Req)
+{
+    uint32_t Head = Queue->Head;
+    uint32_t Tail = __atomic_load_n(&Queue->Tail, __ATOMIC_ACQUIRE);
+
+    if (Head == Tail)
+    {
+        return false;
+    }
+
+    *Req = Queue->Slots[Head & ROBOT_SIM_CTRL_QUEUE_MASK];
+    __atomic_store_n(&Queue->Head, Head + 1, __ATOMIC_RELEASE);
+
+    return true;
+
+} /* End of RobotSimCmdQueuePop() */
@@ -0,0 +1,146 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_cmdq.h
+**
+** Purpose:
+**   Bounded lock-free single-producer/single-consumer queue of control
+**   requests, from ground command handling to the HR loop.
+**
+** Notes:
+**   Exactly one task may push and exactly one task may pop. Like the model
+**   core, this module has no cFE/OSAL dependency.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_cmdq_h_
+#define _robot_sim_cmdq_h_
+
+#include "robot_sim_mission_cfg.h"
+#include "robot_sim_platform_cfg.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+** Control request types
+*/
+#define ROBOT_SIM_REQ_SETPOINT   1
+#define ROBOT_SIM_REQ_GAIN       2
+#define ROBOT_SIM_REQ_MODE       3
+#define ROBOT_SIM_REQ_STOP       4
+#define ROBOT_SIM_REQ_SENSOR     5
+#define ROBOT_SIM_REQ_FAULT      6
+#define ROBOT_SIM_REQ_SEED       7
+#define ROBOT_SIM_REQ_TRIGGER    8
+#define ROBOT_SIM_REQ_TWIST      9
+#define ROBOT_SIM_REQ_TRAJECTORY 10
+#define ROBOT_SIM_REQ_GRAPPLE    11
+#define ROBOT_SIM_REQ_RELEASE    12
+#define ROBOT_SIM_REQ_FREEZE     13
+#define ROBOT_SIM_REQ_TRIM       14
+#define ROBOT_SIM_REQ_VIEW       15
+#define ROBOT_SIM_REQ_PHYSICS    16
+
+typedef struct
+{
+    uint32_t Type;
+    union
+    {
+        float    Goal[NUM_JOINTS]; /**< ROBOT_SIM_REQ_SETPOINT */
+        float    Kp;               /**< ROBOT_SIM_REQ_GAIN */
+        uint32_t Mode;             /**< ROBOT_SIM_REQ_MODE */
+        struct
+        {
+            uint32_t Joint;
+            float    NoiseStdDev;
+            float    BiasDriftStdDev;
+            float    Quantum;
+            float    DropoutProb;
+            uint32_t DelaySamples;
+        } Sensor; /**< ROBOT_SIM_REQ_SENSOR */
+        struct
+        {
+            uint32_t Joint;
+            uint32_t Fault;
+            float    Value;
+        } Fault;       /**< ROBOT_SIM_REQ_FAULT */
+        uint32_t Seed; /**< ROBOT_SIM_REQ_SEED */
+        struct
+        {
+            uint32_t PreSamples;
+            uint32_t PostSamples;
+        } Trigger;      /**< ROBOT_SIM_REQ_TRIGGER, ROBOT_SIM_REQ_TRIM */
+        uint32_t Freeze; /**< ROBOT_SIM_REQ_FREEZE */
+        float Twist[6]; /**< ROBOT_SIM_REQ_TWIST */
+        struct
+        {
+            float Goal[NUM_JOINTS];
+            float Rate[NUM_JOINTS];  /**< rad/s */
+            float Accel[NUM_JOINTS]; /**< rad/s^2 */
+        } Trajectory; /**< ROBOT_SIM_REQ_TRAJECTORY */
+        struct
+        {
+            float Mass;
+            float Com[3];
+            float Inertia[6];
+        } Payload; /**< ROBOT_SIM_REQ_GRAPPLE */
+        struct
+        {
+            uint32_t View;
+            uint32_t NumFields; /**< 0 deletes the view */
+            uint32_t RateDivisor;
+            uint32_t MsgId;
+            uint8_t  Fields[ROBOT_SIM_VIEW_MAX_FIELDS];
+        } View; /**< ROBOT_SIM_REQ_VIEW */
+        struct
+        {
+            uint32_t Backend;
+            int32_t  Fd; /**< Connected co-simulation socket, handed over with the request, or -1 */
+        } Physics; /**< ROBOT_SIM_REQ_PHYSICS */
+    } Data;
+} RobotSimCtrlReq_t;
+
+/*
+** Head is only written by the consumer and Tail only by the producer; they
+** sit on separate cache lines so the two sides do not false-share.
+*/
+typedef struct
+{
+    uint32_t Head;
+    uint8_t  HeadPad[ROBOT_SIM_CACHE_LINE - sizeof(uint32_t)];
+
+    uint32_t Tail;
+    uint32_t OverflowCount; /**< Pushes rejected because the queue was full */
+    uint32_t HighWater;     /**< Deepest occupancy seen by the producer */
+    uint8_t  TailPad[ROBOT_SIM_CACHE_LINE - 3 * sizeof(uint32_t)];
+
+    RobotSimCtrlReq_t Slots[ROBOT_SIM_CTRL_QUEUE_DEPTH];
+} RobotSimCmdQueue_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void RobotSimCmdQueueInit(RobotSimCmdQueue_t *Queue);
+bool RobotSimCmdQueuePush(RobotSimCmdQueue_t *Queue, const RobotSimCtrlReq_t *Req);
+bool RobotSimCmdQueuePop(RobotSimCmdQueue_t *Queue, RobotSimCtrlReq_t *Req);
+
+#endif /* _robot_sim_cmdq_h_ */
@@ -0,0 +1,312 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_cosim.c
+**
+** Purpose:
+**   This file contains the lockstep co-simulation link of the robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_cosim.h"
+
+#include <errno.h>
+#include <poll.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <time.h>
+#include <unistd.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimNowUsec() -- monotonic time for round-trip statistics         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint64_t RobotSimCosimNowUsec(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return (uint64_t)Now.tv_sec * 1000000u + (uint64_t)Now.tv_nsec / 1000u;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimExchange() -- send a request and wait for its reply           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int32_t RobotSimCosimExchange(RobotSimCosim_t *Cosim, RobotSimCosimMsg_t *Msg)
+{
+    struct pollfd Poll;
+    uint64_t      Start;
+    uint32_t      Elapsed;
+    ssize_t       Length;
+    int           Ready;
+
+    if (Cosim->Fd < 0)
+    {
+        return ROBOT_SIM_COSIM_ERROR;
+    }
+
+    Msg->Sequence = ++Cosim->Sequence;
+    Msg->Dt       = Cosim->Dt;
+
+    Start = RobotSimCosimNowUsec();
+
+    if (send(Cosim->Fd, Msg, sizeof(*Msg), MSG_NOSIGNAL) != (ssize_t)sizeof(*Msg))
+    {
+        return ROBOT_SIM_COSIM_ERROR;
+    }
+
+    Poll.fd     = Cosim->Fd;
+    Poll.events = POLLIN;
+    do
+    {
+        Ready = poll(&Poll, 1, Cosim->TimeoutMsec);
+    } while (Ready < 0 && errno == EINTR);
+
+    if (Ready == 0)
+    {
+        return ROBOT_SIM_COSIM_TIMEOUT;
+    }
+
+    Length = Ready > 0 ? recv(Cosim->Fd, Msg, sizeof(*Msg), 0) : -1;
+    if (Length != (ssize_t)sizeof(*Msg) || Msg->Type != ROBOT_SIM_COSIM_STATE || Msg->Sequence != Cosim->Sequence)
+    {
+        return ROBOT_SIM_COSIM_ERROR;
+    }
+
+    Elapsed = (uint32_t)(RobotSimCosimNowUsec() - Start);
+
+    Cosim->LastRoundTripUsec = Elapsed;
+    if (Elapsed > Cosim->MaxRoundTripUsec)
+    {
+        Cosim->MaxRoundTripUsec = Elapsed;
+    }
+
+    return ROBOT_SIM_COSIM_OK;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimInit() -- not connected                                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimCosimInit(RobotSimCosim_t *Cosim)
+{
+    memset(Cosim, 0, sizeof(*Cosim));
+    Cosim->Fd = -1;
+
+} /* End of RobotSimCosimInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimConnect() -- connect to a peer listening on a socket path     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32_t RobotSimCosimConnect(RobotSimCosim_t *Cosim, const char *Path, float Dt, int TimeoutMsec)
+{
+    struct sockaddr_un Addr;
+    int                Fd;
+
+    RobotSimCosimClose(Cosim);
+
+    memset(&Addr, 0, sizeof(Addr));
+    Addr.sun_family = AF_UNIX;
+    if (strlen(Path) >= sizeof(Addr.sun_path))
+    {
+        return ROBOT_SIM_COSIM_ERROR;
+    }
+    strcpy(Addr.sun_path, Path);
+
+    Fd = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    if (Fd < 0)
+    {
+        return ROBOT_SIM_COSIM_ERROR;
+    }
+
+    if (connect(Fd, (struct sockaddr *)&Addr, sizeof(Addr)) != 0)
+    {
+        close(Fd);
+        return ROBOT_SIM_COSIM_ERROR;
+    }
+
+    RobotSimCosimAttach(Cosim, Fd, Dt, TimeoutMsec);
+
+    return ROBOT_SIM_COSIM_OK;
+
+} /* End of RobotSimCosimConnect() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimAttach() -- use an already connected socket, which it owns    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimCosimAttach(RobotSimCosim_t *Cosim, int Fd, float Dt, int TimeoutMsec)
+{
+    RobotSimCosimClose(Cosim);
+
+    Cosim->Fd                = Fd;
+    Cosim->Dt                = Dt;
+    Cosim->TimeoutMsec       = TimeoutMsec;
+    Cosim->StepCount         = 0;
+    Cosim->LastRoundTripUsec = 0;
+    Cosim->MaxRoundTripUsec  = 0;
+
+} /* End of RobotSimCosimAttach() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimSync() -- hand the current joint state to the peer            */
+/*                                                                            */
+/* The peer may start from a state of its own, so whatever it replies with   */
+/* becomes the model state.                                                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32_t RobotSimCosimSync(RobotSimCosim_t *Cosim, RobotSimModel_t *Model)
+{
+    RobotSimCosimMsg_t Msg;
+    int32_t            status;
+    int                i;
+
+    memset(&Msg, 0, sizeof(Msg));
+    Msg.Type = ROBOT_SIM_COSIM_SYNC;
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Msg.Position[i] = Model->Position[i];
+        Msg.Rate[i]     = Model->Applied[i] / Cosim->Dt;
+    }
+
+    status = RobotSimCosimExchange(Cosim, &Msg);
+    if (status == ROBOT_SIM_COSIM_OK)
+    {
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Model->Position[i]      = Msg.Position[i];
+            Model->Applied[i]       = Msg.Rate[i] * Cosim->Dt;
+            Model->AppliedChange[i] = 0.0f;
+        }
+    }
+
+    return status;
+
+} /* End of RobotSimCosimSync() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimStep() -- one physics tick run by the peer                    */
+/*                                                                            */
+/* Takes the place of RobotSimModelPhysics(): the model's command and drive  */
+/* limit go out, and the joint state after the tick comes back. The model    */
+/* is left alone if the peer does not answer.                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32_t RobotSimCosimStep(RobotSimCosim_t *Cosim, RobotSimModel_t *Model, const float *Torque)
+{
+    RobotSimCosimMsg_t Msg;
+    float              Applied;
+    float              Dt2 = Cosim->Dt * Cosim->Dt;
+    int32_t            status;
+    int                i;
+
+    Msg.Type = ROBOT_SIM_COSIM_STEP;
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Msg.Position[i]   = Model->Position[i];
+        Msg.Rate[i]       = Model->Command[i] / Cosim->Dt;
+        Msg.AccelLimit[i] = Model->AccelLimit[i] / Dt2;
+        Msg.Torque[i]     = Torque[i];
+    }
+
+    status = RobotSimCosimExchange(Cosim, &Msg);
+    if (status == ROBOT_SIM_COSIM_OK)
+    {
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Applied                 = Msg.Rate[i] * Cosim->Dt;
+            Model->AppliedChange[i] = Applied - Model->Applied[i];
+            Model->Applied[i]       = Applied;
+            Model->Position[i]      = Msg.Position[i];
+        }
+        Cosim->StepCount++;
+    }
+
+    return status;
+
+} /* End of RobotSimCosimStep() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimClose() -- drop the link                                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimCosimClose(RobotSimCosim_t *Cosim)
+{
+    if (Cosim->Fd >= 0)
+    {
+        close(Cosim->Fd);
+        Cosim->Fd = -1;
+    }
+
+} /* End of RobotSimCosimClose() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimCosimServe() -- peer side: answer requests until the client leaves */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32_t RobotSimCosimServe(int Fd, RobotSimCosimHandler_t Handler, void *Arg)
+{
+    RobotSimCosimMsg_t Request;
+    RobotSimCosimMsg_t Reply;
+    ssize_t            Length;
+
+    for (;;)
+    {
+        Length = recv(Fd, &Request, sizeof(Request), 0);
+        if (Length == 0)
+        {
+            return ROBOT_SIM_COSIM_OK;
+        }
+        if (Length != (ssize_t)sizeof(Request) ||
+            (Request.Type != ROBOT_SIM_COSIM_SYNC && Request.Type != ROBOT_SIM_COSIM_STEP))
+        {
+            return ROBOT_SIM_COSIM_ERROR;
+        }
+
+        memset(&Reply, 0, sizeof(Reply));
+        Reply.Type     = ROBOT_SIM_COSIM_STATE;
+        Reply.Sequence = Request.Sequence;
+        Reply.Dt       = Request.Dt;
+
+        Handler(Arg, &Request, &Reply);
+
+        if (send(Fd, &Reply, sizeof(Reply), MSG_NOSIGNAL) != (ssize_t)sizeof(Reply))
+        {
+            return ROBOT_SIM_COSIM_ERROR;
+        }
+    }
+
+} /* End of RobotSimCosimServe() */
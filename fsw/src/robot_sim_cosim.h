@@ -0,0 +1,102 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_cosim.h
+**
+** Purpose:
+**   Lockstep co-simulation link to an external physics process.
+**
+** Notes:
+**   Each physics tick sends the commanded joint rates, torque-derived
+**   acceleration limits and predicted torques over a Unix seqpacket
+**   socket and waits, up to a timeout, for the joint state after that
+**   tick. Messages are fixed-size records in host byte order; the peer
+**   runs on the same machine. Like the model core, this module has no
+**   cFE/OSAL dependency, but it does need POSIX sockets, so the app only
+**   builds it for hosts, with the ROBOT_SIM_COSIM option.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_cosim_h_
+#define _robot_sim_cosim_h_
+
+#include "robot_sim_mission_cfg.h"
+#include "robot_sim_model.h"
+
+#include <stdint.h>
+
+/*
+** Status codes
+*/
+#define ROBOT_SIM_COSIM_OK       0
+#define ROBOT_SIM_COSIM_ERROR    -1 /**< Socket error, peer gone or protocol violation */
+#define ROBOT_SIM_COSIM_TIMEOUT  -2 /**< No reply in time */
+
+/*
+** Message types
+*/
+#define ROBOT_SIM_COSIM_SYNC  1 /**< Client: initial state, peer replies with its state */
+#define ROBOT_SIM_COSIM_STEP  2 /**< Client: advance one tick */
+#define ROBOT_SIM_COSIM_STATE 3 /**< Peer: joint state after the request */
+
+/*
+** One message, both directions
+*/
+typedef struct
+{
+    uint32_t Type;
+    uint32_t Sequence;   /**< Echoed in the reply */
+    float    Dt;         /**< Seconds per tick */
+    float    Position[NUM_JOINTS];   /**< SYNC, STATE: joint angles, rad */
+    float    Rate[NUM_JOINTS];       /**< SYNC, STATE: joint rates; STEP: commanded rates, rad/s */
+    float    AccelLimit[NUM_JOINTS]; /**< STEP: largest rate change the drives can make, rad/s^2 */
+    float    Torque[NUM_JOINTS];     /**< STEP: predicted joint torques of the last tick, N m */
+} RobotSimCosimMsg_t;
+
+typedef struct
+{
+    int      Fd; /**< -1 when not connected */
+    int      TimeoutMsec;
+    float    Dt;
+    uint32_t Sequence;
+
+    uint32_t StepCount;
+    uint32_t LastRoundTripUsec;
+    uint32_t MaxRoundTripUsec;
+} RobotSimCosim_t;
+
+/*
+** Peer side: fill Reply (type, sequence already set) for a request
+*/
+typedef void (*RobotSimCosimHandler_t)(void *Arg, const RobotSimCosimMsg_t *Request, RobotSimCosimMsg_t *Reply);
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void    RobotSimCosimInit(RobotSimCosim_t *Cosim);
+int32_t RobotSimCosimConnect(RobotSimCosim_t *Cosim, const char *Path, float Dt, int TimeoutMsec);
+void    RobotSimCosimAttach(RobotSimCosim_t *Cosim, int Fd, float Dt, int TimeoutMsec);
+int32_t RobotSimCosimSync(RobotSimCosim_t *Cosim, RobotSimModel_t *Model);
+int32_t RobotSimCosimStep(RobotSimCosim_t *Cosim, RobotSimModel_t *Model, const float *Torque);
+void    RobotSimCosimClose(RobotSimCosim_t *Cosim);
+int32_t RobotSimCosimServe(int Fd, RobotSimCosimHandler_t Handler, void *Arg);
+
+#endif /* _robot_sim_cosim_h_ */
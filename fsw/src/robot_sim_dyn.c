@@ -0,0 +1,459 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_dyn.c
+**
+** Purpose:
+**   This file contains the rigid-body dynamics and payload model of the
+**   robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_dyn.h"
+
+#include <string.h>
+
+static inline void RobotSimDynCross(const float *a, const float *b, float *c)
+{
+    c[0] = a[1] * b[2] - a[2] * b[1];
+    c[1] = a[2] * b[0] - a[0] * b[2];
+    c[2] = a[0] * b[1] - a[1] * b[0];
+}
+
+static inline float RobotSimDynDot(const float *a, const float *b)
+{
+    return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+}
+
+static inline void RobotSimDynRotate(const float R[3][3], const float *v, float *w)
+{
+    w[0] = R[0][0] * v[0] + R[0][1] * v[1] + R[0][2] * v[2];
+    w[1] = R[1][0] * v[0] + R[1][1] * v[1] + R[1][2] * v[2];
+    w[2] = R[2][0] * v[0] + R[2][1] * v[1] + R[2][2] * v[2];
+}
+
+/*
+** Add m * (|v|^2 E - v v') to I: the parallel axis term for an offset v
+*/
+static void RobotSimDynAddPointMass(float I[3][3], float m, const float *v)
+{
+    float vv = RobotSimDynDot(v, v);
+    int   i;
+    int   k;
+
+    for (i = 0; i < 3; i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            I[i][k] += m * ((i == k ? vv : 0.0f) - v[i] * v[k]);
+        }
+    }
+}
+
+/*
+** Inertia in the parent axes: R * I * R'
+*/
+static void RobotSimDynToWorld(const float R[3][3], const float I[3][3], float W[3][3])
+{
+    float T[3][3];
+    int   i;
+    int   k;
+
+    for (i = 0; i < 3; i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            T[i][k] = R[i][0] * I[0][k] + R[i][1] * I[1][k] + R[i][2] * I[2][k];
+        }
+    }
+    for (i = 0; i < 3; i++)
+    {
+        for (k = 0; k < 3; k++)
+        {
+            W[i][k] = T[i][0] * R[k][0] + T[i][1] * R[k][1] + T[i][2] * R[k][2];
+        }
+    }
+}
+
+static void RobotSimDynUnpackInertia(const float *Packed, float I[3][3])
+{
+    I[0][0] = Packed[0];
+    I[1][1] = Packed[1];
+    I[2][2] = Packed[2];
+    I[0][1] = I[1][0] = Packed[3];
+    I[0][2] = I[2][0] = Packed[4];
+    I[1][2] = I[2][1] = Packed[5];
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimDynLoadLink() -- take one link body from the model table           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void RobotSimDynLoadLink(RobotSimDyn_t *Dyn, int Link)
+{
+    const RobotSimJointDesc_t *Joint = &Dyn->Model->Joints[Link];
+
+    Dyn->Mass[Link] = Joint->Mass;
+    memcpy(Dyn->Com[Link], Joint->Com, sizeof(Dyn->Com[Link]));
+    RobotSimDynUnpackInertia(Joint->Inertia, Dyn->Inertia[Link]);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimDynInit() -- bind the model, nothing grappled                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimDynInit(RobotSimDyn_t *Dyn, const RobotSimTable_t *Model)
+{
+    memset(Dyn, 0, sizeof(*Dyn));
+
+    RobotSimDynBind(Dyn, Model);
+
+} /* End of RobotSimDynInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimDynBind() -- switch to a new model, keeping any grappled payload   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimDynBind(RobotSimDyn_t *Dyn, const RobotSimTable_t *Model)
+{
+    int i;
+
+    Dyn->Model = Model;
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        RobotSimDynLoadLink(Dyn, i);
+    }
+
+    if (Dyn->Grappled)
+    {
+        Dyn->Grappled = false;
+        RobotSimDynGrapple(Dyn, &Dyn->Payload);
+    }
+
+} /* End of RobotSimDynBind() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimDynGrapple() -- fold a payload into the last link                  */
+/*                                                                            */
+/* The last link body becomes the composite of the link and the payload:    */
+/* combined mass, mass-weighted CoM, and both inertias moved to that CoM.   */
+/* A payload already held is released first.                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimDynGrapple(RobotSimDyn_t *Dyn, const RobotSimPayload_t *Payload)
+{
+    const int Last = NUM_JOINTS - 1;
+    float     LinkMass;
+    float     LinkCom[3];
+    float     PayloadCom[3];
+    float     PayloadInertia[3][3];
+    float     Offset[3];
+    float     Mass;
+    int       k;
+
+    if (Dyn->Grappled)
+    {
+        RobotSimDynRelease(Dyn);
+    }
+
+    Dyn->Payload  = *Payload;
+    Dyn->Grappled = true;
+
+    LinkMass = Dyn->Mass[Last];
+    memcpy(LinkCom, Dyn->Com[Last], sizeof(LinkCom));
+
+    /*
+    ** The tool frame has the last link's axes, offset by ToolOffset
+    */
+    for (k = 0; k < 3; k++)
+    {
+        PayloadCom[k] = Dyn->Model->ToolOffset[k] + Payload->Com[k];
+    }
+
+    Mass = LinkMass + Payload->Mass;
+    if (!(Mass > 0.0f))
+    {
+        return;
+    }
+
+    for (k = 0; k < 3; k++)
+    {
+        Dyn->Com[Last][k] = (LinkMass * LinkCom[k] + Payload->Mass * PayloadCom[k]) / Mass;
+    }
+    Dyn->Mass[Last] = Mass;
+
+    RobotSimDynUnpackInertia(Payload->Inertia, PayloadInertia);
+    for (k = 0; k < 3; k++)
+    {
+        Offset[k] = LinkCom[k] - Dyn->Com[Last][k];
+    }
+    RobotSimDynAddPointMass(Dyn->Inertia[Last], LinkMass, Offset);
+
+    for (k = 0; k < 3; k++)
+    {
+        Offset[k] = PayloadCom[k] - Dyn->Com[Last][k];
+    }
+    RobotSimDynAddPointMass(PayloadInertia, Payload->Mass, Offset);
+
+    for (k = 0; k < 3; k++)
+    {
+        Dyn->Inertia[Last][k][0] += PayloadInertia[k][0];
+        Dyn->Inertia[Last][k][1] += PayloadInertia[k][1];
+        Dyn->Inertia[Last][k][2] += PayloadInertia[k][2];
+    }
+
+} /* End of RobotSimDynGrapple() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimDynRelease() -- restore the bare last link                         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimDynRelease(RobotSimDyn_t *Dyn)
+{
+    RobotSimDynLoadLink(Dyn, NUM_JOINTS - 1);
+
+    Dyn->Grappled = false;
+    memset(&Dyn->Payload, 0, sizeof(Dyn->Payload));
+    memset(Dyn->Load, 0, sizeof(Dyn->Load));
+
+} /* End of RobotSimDynRelease() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimDynUpdate() -- torques, joint inertias and payload load            */
+/*                                                                            */
+/* Rate and Accel are joint rates (rad/s) and accelerations (rad/s^2). The   */
+/* forward pass propagates link velocities and accelerations out from the   */
+/* fixed base, the backward pass accumulates link wrenches back in and      */
+/* projects them on the joint axes. The joint inertias come from the        */
+/* composite inertia of each subtree, accumulated in the same backward pass. */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimDynUpdate(RobotSimDyn_t *Dyn, RobotSimKin_t *Kin, const float *Rate, const float *Accel)
+{
+    const RobotSimXform_t *Tool;
+    const RobotSimXform_t *Frame;
+    float                  z[NUM_JOINTS][3];
+    float                  r[NUM_JOINTS][3];
+    float                  c[NUM_JOINTS][3];
+    float                  Force[NUM_JOINTS][3];
+    float                  Moment[NUM_JOINTS][3];
+    float                  Iw[NUM_JOINTS][3][3];
+    float                  w[3]     = {0.0f, 0.0f, 0.0f};
+    float                  wd[3]    = {0.0f, 0.0f, 0.0f};
+    float                  ap[3]    = {0.0f, 0.0f, 0.0f};
+    float                  f[3]     = {0.0f, 0.0f, 0.0f};
+    float                  n[3]     = {0.0f, 0.0f, 0.0f};
+    float                  h[3]     = {0.0f, 0.0f, 0.0f};
+    float                  K[3][3]  = {{0.0f}};
+    float                  m        = 0.0f;
+    float                  wz[3];
+    float                  d[3];
+    float                  t1[3];
+    float                  t2[3];
+    float                  ac[3];
+    float                  Iz[3];
+    float                  pz[3];
+    float                  hz[3];
+    int                    i;
+    int                    k;
+
+    Tool = RobotSimKinGetFrame(Kin, ROBOT_SIM_KIN_TOOL);
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Frame = &Kin->Frame[i + 1];
+
+        RobotSimDynRotate(Frame->R, Dyn->Model->Joints[i].Axis, z[i]);
+
+        /*
+        ** Acceleration of this joint's pivot, carried by the parent link
+        */
+        if (i > 0)
+        {
+            for (k = 0; k < 3; k++)
+            {
+                d[k] = Frame->p[k] - Kin->Frame[i].p[k];
+            }
+            RobotSimDynCross(wd, d, t1);
+            RobotSimDynCross(w, d, t2);
+            RobotSimDynCross(w, t2, d);
+            for (k = 0; k < 3; k++)
+            {
+                ap[k] += t1[k] + d[k];
+            }
+        }
+
+        for (k = 0; k < 3; k++)
+        {
+            wz[k] = z[i][k] * Rate[i];
+        }
+        RobotSimDynCross(w, wz, t1);
+        for (k = 0; k < 3; k++)
+        {
+            wd[k] += z[i][k] * Accel[i] + t1[k];
+            w[k] += wz[k];
+        }
+
+        RobotSimDynRotate(Frame->R, Dyn->Com[i], r[i]);
+        for (k = 0; k < 3; k++)
+        {
+            c[i][k] = Frame->p[k] + r[i][k];
+        }
+
+        RobotSimDynCross(wd, r[i], t1);
+        RobotSimDynCross(w, r[i], t2);
+        RobotSimDynCross(w, t2, ac);
+        for (k = 0; k < 3; k++)
+        {
+            ac[k] += ap[k] + t1[k];
+            Force[i][k] = Dyn->Mass[i] * ac[k];
+        }
+
+        RobotSimDynToWorld(Frame->R, Dyn->Inertia[i], Iw[i]);
+        RobotSimDynRotate(Iw[i], wd, t1);
+        RobotSimDynRotate(Iw[i], w, t2);
+        RobotSimDynCross(w, t2, Moment[i]);
+        for (k = 0; k < 3; k++)
+        {
+            Moment[i][k] += t1[k];
+        }
+    }
+
+    /*
+    ** Payload share of the last link wrench, about the tool point
+    */
+    if (Dyn->Grappled)
+    {
+        float Ib[3][3];
+        float Ip[3][3];
+        float cp[3];
+
+        Frame = &Kin->Frame[NUM_JOINTS];
+
+        RobotSimDynRotate(Frame->R, Dyn->Payload.Com, t1);
+        for (k = 0; k < 3; k++)
+        {
+            cp[k] = Tool->p[k] + t1[k];
+            d[k]  = cp[k] - Frame->p[k];
+        }
+        RobotSimDynCross(wd, d, t1);
+        RobotSimDynCross(w, d, t2);
+        RobotSimDynCross(w, t2, ac);
+        for (k = 0; k < 3; k++)
+        {
+            ac[k] += ap[k] + t1[k];
+            Dyn->Load[k] = Dyn->Payload.Mass * ac[k];
+        }
+
+        RobotSimDynUnpackInertia(Dyn->Payload.Inertia, Ib);
+        RobotSimDynToWorld(Frame->R, Ib, Ip);
+        RobotSimDynRotate(Ip, wd, t1);
+        RobotSimDynRotate(Ip, w, t2);
+        RobotSimDynCross(w, t2, Iz);
+        for (k = 0; k < 3; k++)
+        {
+            d[k] = cp[k] - Tool->p[k];
+        }
+        RobotSimDynCross(d, Dyn->Load, t2);
+        for (k = 0; k < 3; k++)
+        {
+            Dyn->Load[k + 3] = t1[k] + Iz[k] + t2[k];
+        }
+    }
+
+    for (i = NUM_JOINTS - 1; i >= 0; i--)
+    {
+        Frame = &Kin->Frame[i + 1];
+
+        /*
+        ** Moment about this pivot: own wrench, then the outer links' force
+        ** moved in from the next pivot
+        */
+        if (i < NUM_JOINTS - 1)
+        {
+            for (k = 0; k < 3; k++)
+            {
+                d[k] = Kin->Frame[i + 2].p[k] - Frame->p[k];
+            }
+            RobotSimDynCross(d, f, t1);
+            for (k = 0; k < 3; k++)
+            {
+                n[k] += t1[k];
+            }
+        }
+        RobotSimDynCross(r[i], Force[i], t1);
+        for (k = 0; k < 3; k++)
+        {
+            n[k] += Moment[i][k] + t1[k];
+            f[k] += Force[i][k];
+        }
+        Dyn->Torque[i] = RobotSimDynDot(z[i], n);
+
+        /*
+        ** Subtree inertia about the base origin, then about this joint axis:
+        ** z'Kz - 2 (p x z).(h x z) + m |p x z|^2
+        */
+        m += Dyn->Mass[i];
+        for (k = 0; k < 3; k++)
+        {
+            h[k] += Dyn->Mass[i] * c[i][k];
+            K[k][0] += Iw[i][k][0];
+            K[k][1] += Iw[i][k][1];
+            K[k][2] += Iw[i][k][2];
+        }
+        RobotSimDynAddPointMass(K, Dyn->Mass[i], c[i]);
+
+        RobotSimDynRotate(K, z[i], Iz);
+        RobotSimDynCross(Frame->p, z[i], pz);
+        RobotSimDynCross(h, z[i], hz);
+        Dyn->JointInertia[i] =
+            RobotSimDynDot(z[i], Iz) - 2.0f * RobotSimDynDot(pz, hz) + m * RobotSimDynDot(pz, pz);
+    }
+
+} /* End of RobotSimDynUpdate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimDynAccelLimit() -- largest increment change per tick of each joint */
+/*                                                                            */
+/* The drive torque limit over the inertia the joint sees at the last        */
+/* update, payload included, as a change of increment over a Dt tick.        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimDynAccelLimit(const RobotSimDyn_t *Dyn, float Dt, float *AccelLimit)
+{
+    int i;
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        AccelLimit[i] = Dyn->Model->Joints[i].MaxTorque / Dyn->JointInertia[i] * (Dt * Dt);
+    }
+
+} /* End of RobotSimDynAccelLimit() */
@@ -0,0 +1,85 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_dyn.h
+**
+** Purpose:
+**   Rigid-body dynamics of the arm: predicted joint torques, effective
+**   joint inertias and the load of a grappled payload.
+**
+** Notes:
+**   Torques come from a recursive Newton-Euler pass over the frames of
+**   the kinematics cache; the arm is in free fall, so there is no gravity
+**   term. A payload is folded into the composite inertia of the last link
+**   when it is grappled and taken out again on release; no other link is
+**   touched. Like the model core, this module has no cFE/OSAL dependency.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_dyn_h_
+#define _robot_sim_dyn_h_
+
+#include "robot_sim_mission_cfg.h"
+#include "robot_sim_kin.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+** Rigid payload held at the tool frame
+*/
+typedef struct
+{
+    float Mass;       /**< kg */
+    float Com[3];     /**< Centre of mass in the tool frame, m */
+    float Inertia[6]; /**< About the CoM in tool axes: xx, yy, zz, xy, xz, yz, kg m^2 */
+} RobotSimPayload_t;
+
+typedef struct
+{
+    const RobotSimTable_t *Model;
+
+    /*
+    ** Link bodies in their own frames, payload included in the last one
+    */
+    float Mass[NUM_JOINTS];
+    float Com[NUM_JOINTS][3];
+    float Inertia[NUM_JOINTS][3][3]; /**< About the link CoM */
+
+    bool              Grappled;
+    RobotSimPayload_t Payload;
+
+    float Torque[NUM_JOINTS];       /**< Predicted joint torques, N m */
+    float JointInertia[NUM_JOINTS]; /**< Diagonal of the joint-space inertia matrix, kg m^2 */
+    float Load[6];                  /**< Payload force (N) and moment about the tool point (N m), world frame */
+} RobotSimDyn_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void RobotSimDynInit(RobotSimDyn_t *Dyn, const RobotSimTable_t *Model);
+void RobotSimDynBind(RobotSimDyn_t *Dyn, const RobotSimTable_t *Model);
+void RobotSimDynGrapple(RobotSimDyn_t *Dyn, const RobotSimPayload_t *Payload);
+void RobotSimDynRelease(RobotSimDyn_t *Dyn);
+void RobotSimDynUpdate(RobotSimDyn_t *Dyn, RobotSimKin_t *Kin, const float *Rate, const float *Accel);
+void RobotSimDynAccelLimit(const RobotSimDyn_t *Dyn, float Dt, float *AccelLimit);
+
+#endif /* _robot_sim_dyn_h_ */
@@ -0,0 +1,175 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+**
+** File: robot_sim_evlim.c
+**
+** Purpose:
+**   This file contains the per-event rate budgets of the robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_evlim.h"
+
+#include <string.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimEvLimInit() -- no budgets, quiet mode off                          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimEvLimInit(RobotSimEvLim_t *Lim)
+{
+    memset(Lim, 0, sizeof(*Lim));
+
+} /* End of RobotSimEvLimInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimEvLimValidate() -- check the budgets of a table before use         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RobotSimEvLimValidate(const RobotSimEventBudget_t *Budget)
+{
+    bool Seen[ROBOT_SIM_EVLIM_MAX_EID];
+    int  i;
+
+    memset(Seen, 0, sizeof(Seen));
+
+    for (i = 0; i < ROBOT_SIM_EVENT_BUDGETS; i++)
+    {
+        if (Budget[i].EventID == 0)
+        {
+            continue;
+        }
+
+        if (Budget[i].EventID >= ROBOT_SIM_EVLIM_MAX_EID || Seen[Budget[i].EventID] ||
+            Budget[i].Burst < Budget[i].Rate)
+        {
+            return false;
+        }
+
+        Seen[Budget[i].EventID] = true;
+    }
+
+    return true;
+
+} /* End of RobotSimEvLimValidate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimEvLimConfigure() -- take on validated budgets, buckets full        */
+/*                                                                            */
+/* Totals and the quiet mode are kept across table updates; counts not yet   */
+/* summarized are dropped with the old buckets.                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimEvLimConfigure(RobotSimEvLim_t *Lim, const RobotSimEventBudget_t *Budget)
+{
+    RobotSimEvLimBucket_t *Bucket;
+    int                    i;
+
+    memset(Lim->Map, 0, sizeof(Lim->Map));
+    memset(Lim->Bucket, 0, sizeof(Lim->Bucket));
+    Lim->NumBuckets = 0;
+
+    for (i = 0; i < ROBOT_SIM_EVENT_BUDGETS; i++)
+    {
+        if (Budget[i].EventID == 0 || Budget[i].EventID >= ROBOT_SIM_EVLIM_MAX_EID)
+        {
+            continue;
+        }
+
+        Bucket          = &Lim->Bucket[Lim->NumBuckets++];
+        Bucket->EventID = Budget[i].EventID;
+        Bucket->Flags   = Budget[i].Flags;
+        Bucket->Rate    = Budget[i].Rate;
+        Bucket->Burst   = Budget[i].Burst;
+        Bucket->Tokens  = Budget[i].Burst;
+
+        Lim->Map[Budget[i].EventID] = (uint8_t)Lim->NumBuckets;
+    }
+
+} /* End of RobotSimEvLimConfigure() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimEvLimTake() -- true if the event may be sent now                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RobotSimEvLimTake(RobotSimEvLim_t *Lim, uint16_t EventID)
+{
+    RobotSimEvLimBucket_t *Bucket;
+
+    if (EventID >= ROBOT_SIM_EVLIM_MAX_EID || Lim->Map[EventID] == 0)
+    {
+        return true;
+    }
+
+    Bucket = &Lim->Bucket[Lim->Map[EventID] - 1];
+
+    if (Lim->Quiet && (Bucket->Flags & ROBOT_SIM_EVENT_CONFIRM) != 0)
+    {
+        Lim->QuietTotal++;
+        return false;
+    }
+
+    if (Bucket->Tokens == 0)
+    {
+        Bucket->SuppressedCount++;
+        Lim->SuppressedTotal++;
+        return false;
+    }
+
+    Bucket->Tokens--;
+    Bucket->SentCount++;
+
+    return true;
+
+} /* End of RobotSimEvLimTake() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimEvLimRefill() -- add one period's tokens to every bucket           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimEvLimRefill(RobotSimEvLim_t *Lim)
+{
+    RobotSimEvLimBucket_t *Bucket;
+    uint16_t               i;
+
+    for (i = 0; i < Lim->NumBuckets; i++)
+    {
+        Bucket = &Lim->Bucket[i];
+
+        if (Bucket->Burst - Bucket->Tokens > Bucket->Rate)
+        {
+            Bucket->Tokens += Bucket->Rate;
+        }
+        else
+        {
+            Bucket->Tokens = Bucket->Burst;
+        }
+    }
+
+} /* End of RobotSimEvLimRefill() */
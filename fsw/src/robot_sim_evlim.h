@@ -0,0 +1,87 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+**
+** File: robot_sim_evlim.h
+**
+** Purpose:
+**   Per-event rate budgets, so a fast command stream cannot flood EVS.
+**
+** Notes:
+**   Each budgeted event ID has a token bucket. An event is sent only if
+**   its bucket holds a token; otherwise it is counted as suppressed, and
+**   the count is reported in a summary after the next refill. In quiet
+**   mode, events flagged ROBOT_SIM_EVENT_CONFIRM are counted instead of
+**   sent whatever their budget. The check is made before the event text
+**   is formatted. Like the model core, this module has no cFE/OSAL
+**   dependency.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_evlim_h_
+#define _robot_sim_evlim_h_
+
+#include "robot_sim_mission_cfg.h"
+#include "robot_sim_table.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+** Event IDs below this can be budgeted
+*/
+#define ROBOT_SIM_EVLIM_MAX_EID 32
+
+typedef struct
+{
+    uint16_t EventID;
+    uint16_t Flags;
+    uint16_t Rate;
+    uint16_t Burst;
+    uint16_t Tokens;
+    uint16_t Spare;
+
+    uint32_t SentCount;
+    uint32_t SuppressedCount; /**< Since the last summary */
+} RobotSimEvLimBucket_t;
+
+typedef struct
+{
+    bool    Quiet;
+    uint8_t Map[ROBOT_SIM_EVLIM_MAX_EID]; /**< Bucket index + 1, 0 if not budgeted */
+
+    uint16_t              NumBuckets;
+    RobotSimEvLimBucket_t Bucket[ROBOT_SIM_EVENT_BUDGETS];
+
+    uint32_t SuppressedTotal; /**< Events dropped for lack of budget */
+    uint32_t QuietTotal;      /**< Confirmations counted in quiet mode */
+} RobotSimEvLim_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void RobotSimEvLimInit(RobotSimEvLim_t *Lim);
+bool RobotSimEvLimValidate(const RobotSimEventBudget_t *Budget);
+void RobotSimEvLimConfigure(RobotSimEvLim_t *Lim, const RobotSimEventBudget_t *Budget);
+bool RobotSimEvLimTake(RobotSimEvLim_t *Lim, uint16_t EventID);
+void RobotSimEvLimRefill(RobotSimEvLim_t *Lim);
+
+#endif /* _robot_sim_evlim_h_ */
@@ -0,0 +1,264 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_kin.c
+**
+** Purpose:
+**   This file contains the forward kinematics and frame cache of the
+**   robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_kin.h"
+
+#include <math.h>
+#include <string.h>
+
+/*
+** Tolerance on the length of joint axes
+*/
+#define ROBOT_SIM_KIN_AXIS_TOL 1.0e-3f
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimKinAdvance() -- Child = Parent * Trans(Origin) * Rot(Axis, Angle)  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void RobotSimKinAdvance(const RobotSimXform_t *Parent, const RobotSimJointDesc_t *Joint, float Angle,
+                               RobotSimXform_t *Child)
+{
+    const float *a = Joint->Axis;
+    float        c = cosf(Angle);
+    float        s = sinf(Angle);
+    float        v = 1.0f - c;
+    float        Rot[3][3];
+    int          i;
+    int          k;
+
+    /*
+    ** Rodrigues' formula
+    */
+    Rot[0][0] = c + a[0] * a[0] * v;
+    Rot[0][1] = a[0] * a[1] * v - a[2] * s;
+    Rot[0][2] = a[0] * a[2] * v + a[1] * s;
+    Rot[1][0] = a[1] * a[0] * v + a[2] * s;
+    Rot[1][1] = c + a[1] * a[1] * v;
+    Rot[1][2] = a[1] * a[2] * v - a[0] * s;
+    Rot[2][0] = a[2] * a[0] * v - a[1] * s;
+    Rot[2][1] = a[2] * a[1] * v + a[0] * s;
+    Rot[2][2] = c + a[2] * a[2] * v;
+
+    for (i = 0; i < 3; i++)
+    {
+        Child->p[i] = Parent->p[i] + Parent->R[i][0] * Joint->Origin[0] + Parent->R[i][1] * Joint->Origin[1] +
+                      Parent->R[i][2] * Joint->Origin[2];
+
+        for (k = 0; k < 3; k++)
+        {
+            Child->R[i][k] = Parent->R[i][0] * Rot[0][k] + Parent->R[i][1] * Rot[1][k] + Parent->R[i][2] * Rot[2][k];
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimKinValidate() -- check a kinematic description before use         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RobotSimKinValidate(const RobotSimTable_t *Model)
+{
+    const RobotSimJointDesc_t *Joint;
+    float                      Norm;
+    int                        i;
+
+    if (Model->NumJoints != NUM_JOINTS)
+    {
+        return false;
+    }
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Joint = &Model->Joints[i];
+        Norm  = sqrtf(Joint->Axis[0] * Joint->Axis[0] + Joint->Axis[1] * Joint->Axis[1] +
+                     Joint->Axis[2] * Joint->Axis[2]);
+
+        if (Joint->Type != ROBOT_SIM_JOINT_REVOLUTE || !(fabsf(Norm - 1.0f) < ROBOT_SIM_KIN_AXIS_TOL) ||
+            !(Joint->MinAngle < Joint->MaxAngle) || !(Joint->Mass >= 0.0f))
+        {
+            return false;
+        }
+    }
+
+    return true;
+
+} /* End of RobotSimKinValidate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimKinInit() -- bind a kinematic model, all links dirty               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimKinInit(RobotSimKin_t *Kin, const RobotSimTable_t *Model)
+{
+    memset(Kin, 0, sizeof(*Kin));
+
+    Kin->Frame[0].R[0][0] = 1.0f;
+    Kin->Frame[0].R[1][1] = 1.0f;
+    Kin->Frame[0].R[2][2] = 1.0f;
+
+    RobotSimKinBind(Kin, Model);
+
+} /* End of RobotSimKinInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimKinBind() -- switch to a new kinematic model, all links dirty      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimKinBind(RobotSimKin_t *Kin, const RobotSimTable_t *Model)
+{
+    Kin->Model     = Model;
+    Kin->DirtyFrom = 1;
+
+} /* End of RobotSimKinBind() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimKinSetJoints() -- record new joint angles, dirtying descendants    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimKinSetJoints(RobotSimKin_t *Kin, const float *Angle)
+{
+    uint32_t i;
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        if (Angle[i] != Kin->Angle[i])
+        {
+            Kin->Angle[i] = Angle[i];
+            if (i + 1 < Kin->DirtyFrom)
+            {
+                Kin->DirtyFrom = i + 1;
+            }
+        }
+    }
+
+} /* End of RobotSimKinSetJoints() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimKinGetFrame() -- world transform of a link, computed on demand     */
+/*                                                                            */
+/* Only the dirty links up to the requested one are recomputed; links past   */
+/* it stay dirty until somebody asks for them.                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+const RobotSimXform_t *RobotSimKinGetFrame(RobotSimKin_t *Kin, uint32_t Link)
+{
+    const RobotSimXform_t *Last;
+    RobotSimXform_t       *Tool;
+    uint32_t               i;
+
+    if (Link >= ROBOT_SIM_KIN_FRAMES)
+    {
+        return NULL;
+    }
+
+    if (Link < Kin->DirtyFrom)
+    {
+        Kin->HitCount++;
+        return &Kin->Frame[Link];
+    }
+
+    Kin->MissCount++;
+
+    for (i = Kin->DirtyFrom; i <= Link; i++)
+    {
+        if (i == ROBOT_SIM_KIN_TOOL)
+        {
+            Last = &Kin->Frame[NUM_JOINTS];
+            Tool = &Kin->Frame[ROBOT_SIM_KIN_TOOL];
+
+            memcpy(Tool->R, Last->R, sizeof(Tool->R));
+            Tool->p[0] = Last->p[0] + Last->R[0][0] * Kin->Model->ToolOffset[0] +
+                         Last->R[0][1] * Kin->Model->ToolOffset[1] + Last->R[0][2] * Kin->Model->ToolOffset[2];
+            Tool->p[1] = Last->p[1] + Last->R[1][0] * Kin->Model->ToolOffset[0] +
+                         Last->R[1][1] * Kin->Model->ToolOffset[1] + Last->R[1][2] * Kin->Model->ToolOffset[2];
+            Tool->p[2] = Last->p[2] + Last->R[2][0] * Kin->Model->ToolOffset[0] +
+                         Last->R[2][1] * Kin->Model->ToolOffset[1] + Last->R[2][2] * Kin->Model->ToolOffset[2];
+        }
+        else
+        {
+            RobotSimKinAdvance(&Kin->Frame[i - 1], &Kin->Model->Joints[i - 1], Kin->Angle[i - 1], &Kin->Frame[i]);
+        }
+
+        Kin->RecomputeCount++;
+    }
+
+    Kin->DirtyFrom = Link + 1;
+
+    return &Kin->Frame[Link];
+
+} /* End of RobotSimKinGetFrame() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimKinJacobian() -- world-frame geometric Jacobian of the tool        */
+/*                                                                            */
+/* Rows 0-2 are linear and 3-5 angular velocity of the tool point. Column i  */
+/* is built from link i+1, which holds joint i's pivot and, since the joint  */
+/* rotates about its own axis, the same world axis as its parent.            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimKinJacobian(RobotSimKin_t *Kin, float J[6][NUM_JOINTS])
+{
+    const RobotSimXform_t *Tool;
+    const RobotSimXform_t *Link;
+    const float           *a;
+    float                  z[3];
+    float                  r[3];
+    int                    i;
+    int                    k;
+
+    Tool = RobotSimKinGetFrame(Kin, ROBOT_SIM_KIN_TOOL);
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Link = &Kin->Frame[i + 1];
+        a    = Kin->Model->Joints[i].Axis;
+
+        for (k = 0; k < 3; k++)
+        {
+            z[k] = Link->R[k][0] * a[0] + Link->R[k][1] * a[1] + Link->R[k][2] * a[2];
+            r[k] = Tool->p[k] - Link->p[k];
+        }
+
+        J[0][i] = z[1] * r[2] - z[2] * r[1];
+        J[1][i] = z[2] * r[0] - z[0] * r[2];
+        J[2][i] = z[0] * r[1] - z[1] * r[0];
+        J[3][i] = z[0];
+        J[4][i] = z[1];
+        J[5][i] = z[2];
+    }
+
+} /* End of RobotSimKinJacobian() */
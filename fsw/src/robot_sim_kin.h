@@ -0,0 +1,80 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_kin.h
+**
+** Purpose:
+**   Forward kinematics of the arm with a lazily evaluated frame cache.
+**
+** Notes:
+**   Frames are keyed by link: link 0 is the base, link i (1..NUM_JOINTS)
+**   is moved by joint i-1, and ROBOT_SIM_KIN_TOOL is the tool frame. The
+**   chain is serial, so moving joint i dirties every link after it and
+**   the dirty set is just the lowest dirty link. Like the model core, this
+**   module has no cFE/OSAL dependency.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_kin_h_
+#define _robot_sim_kin_h_
+
+#include "robot_sim_mission_cfg.h"
+#include "robot_sim_table.h"
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define ROBOT_SIM_KIN_TOOL   (NUM_JOINTS + 1)
+#define ROBOT_SIM_KIN_FRAMES (NUM_JOINTS + 2)
+
+/*
+** Rigid transform from a frame to the world
+*/
+typedef struct
+{
+    float R[3][3];
+    float p[3];
+} RobotSimXform_t;
+
+typedef struct
+{
+    const RobotSimTable_t *Model; /**< Used in place, normally the loaded table image */
+
+    float           Angle[NUM_JOINTS]; /**< Joint angles the frames are valid for */
+    uint32_t        DirtyFrom;         /**< Lowest link that must be recomputed */
+    RobotSimXform_t Frame[ROBOT_SIM_KIN_FRAMES];
+
+    uint32_t HitCount;       /**< Queries answered from the cache */
+    uint32_t MissCount;      /**< Queries that had to recompute */
+    uint32_t RecomputeCount; /**< Link transforms recomputed */
+} RobotSimKin_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+bool                   RobotSimKinValidate(const RobotSimTable_t *Model);
+void                   RobotSimKinInit(RobotSimKin_t *Kin, const RobotSimTable_t *Model);
+void                   RobotSimKinBind(RobotSimKin_t *Kin, const RobotSimTable_t *Model);
+void                   RobotSimKinSetJoints(RobotSimKin_t *Kin, const float *Angle);
+const RobotSimXform_t *RobotSimKinGetFrame(RobotSimKin_t *Kin, uint32_t Link);
+void                   RobotSimKinJacobian(RobotSimKin_t *Kin, float J[6][NUM_JOINTS]);
+
+#endif /* _robot_sim_kin_h_ */
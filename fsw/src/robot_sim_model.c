@@ -0,0 +1,381 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_model.c
+**
+** Purpose:
+**   This file contains the control law and physics core of the robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_model.h"
+
+#include <math.h>
+#include <string.h>
+
+/*
+** Symmetric clamp written as min/max so the compiler keeps it branch-free
+*/
+static inline float RobotSimModelClamp(float Value, float Limit)
+{
+    Value = (Value > Limit) ? Limit : Value;
+    return (Value < -Limit) ? -Limit : Value;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelInit() -- put the arm at rest at the zero position            */
+/*                                                                            */
+/* The controller starts as a plain proportional law with gain Kp and no     */
+/* limits, feedforward or scheduling, until RobotSimModelSetGains().          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelInit(RobotSimModel_t *Model, float Kp)
+{
+    int i;
+    int r;
+
+    memset(Model, 0, sizeof(*Model));
+    Model->Mode = ROBOT_SIM_MODE_POSITION;
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Model->MinPosition[i] = -ROBOT_SIM_UNLIMITED;
+        Model->MaxPosition[i] = ROBOT_SIM_UNLIMITED;
+        Model->AccelLimit[i]  = ROBOT_SIM_UNLIMITED;
+
+        Model->Pid.IntegratorLimit[i] = ROBOT_SIM_UNLIMITED;
+        Model->Pid.CommandLimit[i]    = ROBOT_SIM_UNLIMITED;
+
+        for (r = 0; r < ROBOT_SIM_PID_REGIONS - 1; r++)
+        {
+            Model->Pid.Breakpoint[r][i] = ROBOT_SIM_UNLIMITED;
+        }
+    }
+
+    RobotSimModelSetKp(Model, Kp);
+
+} /* End of RobotSimModelInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelSetGains() -- replace the PID configuration                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelSetGains(RobotSimModel_t *Model, const RobotSimPidConfig_t *Pid)
+{
+    Model->Pid = *Pid;
+
+} /* End of RobotSimModelSetGains() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelApplyTable() -- joint limits and gains from the arm table     */
+/*                                                                            */
+/* Dt is the physics period in seconds, which turns the joint rate limits    */
+/* into increments per tick.                                                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelApplyTable(RobotSimModel_t *Model, const RobotSimTable_t *Tbl, float Dt)
+{
+    RobotSimPidConfig_t         Pid;
+    const RobotSimJointGains_t *Gains;
+    float                       Min[NUM_JOINTS];
+    float                       Max[NUM_JOINTS];
+    int                         i;
+    int                         r;
+
+    /*
+    ** The table is laid out per joint for readability, the controller
+    ** per gain so the control law runs across joints
+    */
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Gains  = &Tbl->Joints[i].Gains;
+        Min[i] = Tbl->Joints[i].MinAngle;
+        Max[i] = Tbl->Joints[i].MaxAngle;
+
+        for (r = 0; r < ROBOT_SIM_PID_REGIONS; r++)
+        {
+            Pid.Kp[r][i] = Gains->Kp[r];
+            Pid.Ki[r][i] = Gains->Ki[r];
+            Pid.Kd[r][i] = Gains->Kd[r];
+        }
+        for (r = 0; r < ROBOT_SIM_PID_REGIONS - 1; r++)
+        {
+            Pid.Breakpoint[r][i] = Gains->Breakpoint[r];
+        }
+
+        Pid.IntegratorLimit[i] = Gains->IntegratorLimit;
+        Pid.CommandLimit[i]    = Gains->MaxRate * Dt;
+        Pid.BackCalcGain[i]    = Gains->BackCalcGain;
+        Pid.VelFF[i]           = Gains->VelFF;
+        Pid.AccFF[i]           = Gains->AccFF;
+    }
+
+    RobotSimModelSetLimits(Model, Min, Max);
+    RobotSimModelSetGains(Model, &Pid);
+
+} /* End of RobotSimModelApplyTable() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelSetKp() -- one proportional gain for every joint and region   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelSetKp(RobotSimModel_t *Model, float Kp)
+{
+    int i;
+    int r;
+
+    for (r = 0; r < ROBOT_SIM_PID_REGIONS; r++)
+    {
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Model->Pid.Kp[r][i] = Kp;
+        }
+    }
+
+} /* End of RobotSimModelSetKp() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelSetLimits() -- set the joint stops enforced by the physics    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelSetLimits(RobotSimModel_t *Model, const float *Min, const float *Max)
+{
+    memcpy(Model->MinPosition, Min, sizeof(Model->MinPosition));
+    memcpy(Model->MaxPosition, Max, sizeof(Model->MaxPosition));
+
+} /* End of RobotSimModelSetLimits() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelSetAccelLimit() -- limit how fast the joint rates can change  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelSetAccelLimit(RobotSimModel_t *Model, const float *AccelLimit)
+{
+    memcpy(Model->AccelLimit, AccelLimit, sizeof(Model->AccelLimit));
+
+} /* End of RobotSimModelSetAccelLimit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelSetGoal() -- set the commanded joint angles                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelSetGoal(RobotSimModel_t *Model, const float *Goal)
+{
+    memcpy(Model->Goal, Goal, sizeof(Model->Goal));
+    memset(Model->GoalRate, 0, sizeof(Model->GoalRate));
+    memset(Model->GoalAccel, 0, sizeof(Model->GoalAccel));
+
+} /* End of RobotSimModelSetGoal() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelSetTrajectory() -- goal with its rate and acceleration        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelSetTrajectory(RobotSimModel_t *Model, const float *Goal, const float *Rate, const float *Accel)
+{
+    memcpy(Model->Goal, Goal, sizeof(Model->Goal));
+    memcpy(Model->GoalRate, Rate, sizeof(Model->GoalRate));
+    memcpy(Model->GoalAccel, Accel, sizeof(Model->GoalAccel));
+
+} /* End of RobotSimModelSetTrajectory() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelSetRate() -- set the joint increments used in velocity mode   */
+/*                                                                            */
+/* Increments past a joint's command limit scale the whole vector down until */
+/* the fastest joint is at its limit. Clamping joints one by one would bend  */
+/* the tool path.                                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelSetRate(RobotSimModel_t *Model, const float *Increment)
+{
+    float Scale = 1.0f;
+    float Magnitude;
+    int   i;
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Magnitude = fabsf(Increment[i]);
+        if (Magnitude * Scale > Model->Pid.CommandLimit[i])
+        {
+            Scale = Model->Pid.CommandLimit[i] / Magnitude;
+        }
+    }
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Model->Command[i] = Increment[i] * Scale;
+    }
+
+} /* End of RobotSimModelSetRate() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelStop() -- halt the arm where it is                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelStop(RobotSimModel_t *Model)
+{
+    memcpy(Model->Goal, Model->Position, sizeof(Model->Goal));
+    memset(Model->GoalRate, 0, sizeof(Model->GoalRate));
+    memset(Model->GoalAccel, 0, sizeof(Model->GoalAccel));
+    memset(Model->Command, 0, sizeof(Model->Command));
+    memset(Model->Terms.I, 0, sizeof(Model->Terms.I));
+
+} /* End of RobotSimModelStop() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelControl() -- evaluate the control law                         */
+/*                                                                            */
+/* Per joint: scheduled gains, P on error, D on measurement (no kick on goal */
+/* steps), goal rate and acceleration feedforward, and an integrator that is */
+/* clamped and bled back by the amount the command saturates. The loop body */
+/* is branch-free so it runs as one kernel across the joint arrays.          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelControl(RobotSimModel_t *Model)
+{
+    const RobotSimPidConfig_t *Pid   = &Model->Pid;
+    RobotSimPidTerms_t        *Terms = &Model->Terms;
+    float                      Kp;
+    float                      Ki;
+    float                      Kd;
+    float                      Above;
+    float                      Integral;
+    float                      Unsat;
+    float                      Sat;
+    int                        i;
+    int                        r;
+
+    /*
+    ** The command comes from RobotSimModelSetRate(); the goal follows the
+    ** arm so that leaving velocity mode holds it where it is
+    */
+    if (Model->Mode == ROBOT_SIM_MODE_VELOCITY)
+    {
+        memcpy(Model->Goal, Model->Position, sizeof(Model->Goal));
+        memcpy(Model->PrevPosition, Model->Position, sizeof(Model->PrevPosition));
+        memset(Model->Error, 0, sizeof(Model->Error));
+        memset(Terms->I, 0, sizeof(Terms->I));
+        return;
+    }
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Kp = Pid->Kp[0][i];
+        Ki = Pid->Ki[0][i];
+        Kd = Pid->Kd[0][i];
+        for (r = 1; r < ROBOT_SIM_PID_REGIONS; r++)
+        {
+            Above = (float)(Model->Position[i] > Pid->Breakpoint[r - 1][i]);
+            Kp += Above * (Pid->Kp[r][i] - Pid->Kp[r - 1][i]);
+            Ki += Above * (Pid->Ki[r][i] - Pid->Ki[r - 1][i]);
+            Kd += Above * (Pid->Kd[r][i] - Pid->Kd[r - 1][i]);
+        }
+
+        Model->Error[i] = Model->Goal[i] - Model->Position[i];
+
+        Integral = RobotSimModelClamp(Terms->I[i] + Ki * Model->Error[i], Pid->IntegratorLimit[i]);
+
+        Terms->Kp[i] = Kp;
+        Terms->Ki[i] = Ki;
+        Terms->Kd[i] = Kd;
+        Terms->P[i]  = Kp * Model->Error[i];
+        Terms->D[i]  = -Kd * (Model->Position[i] - Model->PrevPosition[i]);
+        Terms->FF[i] = Pid->VelFF[i] * Model->GoalRate[i] + Pid->AccFF[i] * Model->GoalAccel[i];
+
+        Unsat = Terms->P[i] + Integral + Terms->D[i] + Terms->FF[i];
+        Sat   = RobotSimModelClamp(Unsat, Pid->CommandLimit[i]);
+
+        Integral += Pid->BackCalcGain[i] * (Sat - Unsat);
+
+        Terms->I[i]            = RobotSimModelClamp(Integral, Pid->IntegratorLimit[i]);
+        Model->Command[i]      = Sat;
+        Model->PrevPosition[i] = Model->Position[i];
+    }
+
+    /*
+    ** Holding still must not wind the integrators up against the error
+    */
+    if (Model->Mode == ROBOT_SIM_MODE_HOLD)
+    {
+        memset(Model->Command, 0, sizeof(Model->Command));
+        memset(Terms->I, 0, sizeof(Terms->I));
+    }
+
+} /* End of RobotSimModelControl() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelPhysics() -- integrate the arm over one physics tick          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelPhysics(RobotSimModel_t *Model)
+{
+    int i;
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        /*
+        ** The drives can only change the joint rate as fast as their
+        ** torque allows against the inertia they move
+        */
+        Model->AppliedChange[i] = RobotSimModelClamp(Model->Command[i] - Model->Applied[i], Model->AccelLimit[i]);
+        Model->Applied[i] += Model->AppliedChange[i];
+        Model->Position[i] += Model->Applied[i];
+
+        if (Model->Position[i] < Model->MinPosition[i])
+        {
+            Model->Position[i] = Model->MinPosition[i];
+            Model->Applied[i]  = 0.0f;
+        }
+        else if (Model->Position[i] > Model->MaxPosition[i])
+        {
+            Model->Position[i] = Model->MaxPosition[i];
+            Model->Applied[i]  = 0.0f;
+        }
+    }
+
+} /* End of RobotSimModelPhysics() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimModelStep() -- control and physics at the same rate                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimModelStep(RobotSimModel_t *Model)
+{
+    RobotSimModelControl(Model);
+    RobotSimModelPhysics(Model);
+
+} /* End of RobotSimModelStep() */
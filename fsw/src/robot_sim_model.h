@@ -0,0 +1,123 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_model.h
+**
+** Purpose:
+**   Control law and physics core of the robot sim.
+**
+** Notes:
+**   This module must not call into cFE or OSAL. It is shared between the
+**   flight app and the headless host tools (see tools/robot_sim_batch).
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_model_h_
+#define _robot_sim_model_h_
+
+#include "robot_sim_mission_cfg.h"
+#include "robot_sim_table.h"
+
+/*
+** Default proportional gain applied per control tick
+*/
+#define ROBOT_SIM_DEFAULT_KP 0.01f
+
+/*
+** Joint travel used until a kinematic model supplies real limits
+*/
+#define ROBOT_SIM_UNLIMITED 1.0e30f
+
+/*
+** Per-joint PID configuration. Arrays run across joints so the control
+** law is evaluated as one kernel; the active gains of a joint come from
+** the region its own angle is in, region r covering angles above
+** Breakpoint[r-1] and up to Breakpoint[r]. All gains are per control tick.
+*/
+typedef struct
+{
+    float Kp[ROBOT_SIM_PID_REGIONS][NUM_JOINTS];
+    float Ki[ROBOT_SIM_PID_REGIONS][NUM_JOINTS];
+    float Kd[ROBOT_SIM_PID_REGIONS][NUM_JOINTS];
+    float Breakpoint[ROBOT_SIM_PID_REGIONS - 1][NUM_JOINTS]; /**< Ascending per joint, rad */
+    float IntegratorLimit[NUM_JOINTS]; /**< Clamp on the integral term, rad per tick */
+    float CommandLimit[NUM_JOINTS];  /**< Clamp on the joint increment, rad per tick */
+    float BackCalcGain[NUM_JOINTS];  /**< Share of the saturation excess bled off the integrator */
+    float VelFF[NUM_JOINTS];         /**< Goal rate feedforward gain */
+    float AccFF[NUM_JOINTS];         /**< Goal acceleration feedforward gain */
+} RobotSimPidConfig_t;
+
+/*
+** Gains in effect and the terms of the last control step, per joint
+*/
+typedef struct
+{
+    float Kp[NUM_JOINTS];
+    float Ki[NUM_JOINTS];
+    float Kd[NUM_JOINTS];
+    float P[NUM_JOINTS];
+    float I[NUM_JOINTS]; /**< Integrator state, after anti-windup */
+    float D[NUM_JOINTS];
+    float FF[NUM_JOINTS];
+} RobotSimPidTerms_t;
+
+/*
+** Simulation state of one arm
+*/
+typedef struct
+{
+    float Position[NUM_JOINTS];      /**< Current joint angles */
+    float Goal[NUM_JOINTS];          /**< Commanded joint angles */
+    float GoalRate[NUM_JOINTS];      /**< Goal rate from the trajectory source, rad per tick */
+    float GoalAccel[NUM_JOINTS];     /**< Goal acceleration from the trajectory source, rad per tick^2 */
+    float Error[NUM_JOINTS];         /**< Goal minus position, from the last control step */
+    float Command[NUM_JOINTS];       /**< Joint increment per physics tick, held between control steps */
+    float Applied[NUM_JOINTS];       /**< Joint increment actually applied on the last physics tick */
+    float AppliedChange[NUM_JOINTS]; /**< Change of the applied increment on the last physics tick */
+    float AccelLimit[NUM_JOINTS];    /**< Largest change of the applied increment per tick */
+    float MinPosition[NUM_JOINTS];   /**< Lower joint stop */
+    float MaxPosition[NUM_JOINTS];   /**< Upper joint stop */
+    float PrevPosition[NUM_JOINTS];  /**< Position at the last control step, for the derivative */
+
+    RobotSimPidConfig_t Pid;
+    RobotSimPidTerms_t  Terms;
+
+    int Mode; /**< ROBOT_SIM_MODE_* */
+} RobotSimModel_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void RobotSimModelInit(RobotSimModel_t *Model, float Kp);
+void RobotSimModelSetLimits(RobotSimModel_t *Model, const float *Min, const float *Max);
+void RobotSimModelSetAccelLimit(RobotSimModel_t *Model, const float *AccelLimit);
+void RobotSimModelSetGains(RobotSimModel_t *Model, const RobotSimPidConfig_t *Pid);
+void RobotSimModelApplyTable(RobotSimModel_t *Model, const RobotSimTable_t *Tbl, float Dt);
+void RobotSimModelSetKp(RobotSimModel_t *Model, float Kp);
+void RobotSimModelSetGoal(RobotSimModel_t *Model, const float *Goal);
+void RobotSimModelSetTrajectory(RobotSimModel_t *Model, const float *Goal, const float *Rate, const float *Accel);
+void RobotSimModelSetRate(RobotSimModel_t *Model, const float *Increment);
+void RobotSimModelStop(RobotSimModel_t *Model);
+void RobotSimModelControl(RobotSimModel_t *Model);
+void RobotSimModelPhysics(RobotSimModel_t *Model);
+void RobotSimModelStep(RobotSimModel_t *Model);
+
+#endif /* _robot_sim_model_h_ */
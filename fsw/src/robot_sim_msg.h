@@ -30,11 +30,32 @@
 #ifndef _robot_sim_msg_h_
 #define _robot_sim_msg_h_
 
+#include "robot_sim_mission_cfg.h"
+
 /*
 ** Robot Sim command codes
 */
 #define ROBOT_SIM_NOOP_CC           0
 #define ROBOT_SIM_SET_JOINTS_CC     1
+#define ROBOT_SIM_SET_KP_CC         2
+#define ROBOT_SIM_SET_MODE_CC       3
+#define ROBOT_SIM_STOP_CC           4
+#define ROBOT_SIM_SET_SENSOR_CC     5
+#define ROBOT_SIM_SENSOR_FAULT_CC   6
+#define ROBOT_SIM_SENSOR_SEED_CC    7
+#define ROBOT_SIM_REC_TRIGGER_CC    8
+#define ROBOT_SIM_REC_FREEZE_CC     9
+#define ROBOT_SIM_REC_TRIM_CC       10
+#define ROBOT_SIM_REC_DUMP_CC       11
+#define ROBOT_SIM_SET_TWIST_CC      12
+#define ROBOT_SIM_SET_TRAJECTORY_CC 13
+#define ROBOT_SIM_GRAPPLE_CC        14
+#define ROBOT_SIM_RELEASE_CC        15
+#define ROBOT_SIM_DEFINE_VIEW_CC    16
+#define ROBOT_SIM_SET_PHYSICS_CC    17
+#define ROBOT_SIM_SET_EVENT_MODE_CC 18
+
+#define ROBOT_SIM_NUM_CMD_CODES 19
 
 /*************************************************************************/
 
@@ -58,6 +79,145 @@ typedef struct
     float joint6;
 } RobotSimJointCmd_t;
 
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    float Kp;
+} RobotSimSetKpCmd_t;
+
+/*
+** Tool twist for velocity mode, world frame: vx, vy, vz (m/s) then
+** wx, wy, wz (rad/s). Held until the next twist, a mode change or a stop.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    float Twist[6];
+} RobotSimSetTwistCmd_t;
+
+/*
+** Trajectory point: goal angles (rad) with the goal rate (rad/s) and
+** acceleration (rad/s^2) fed forward by the joint controllers
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    float Position[NUM_JOINTS];
+    float Velocity[NUM_JOINTS];
+    float Acceleration[NUM_JOINTS];
+} RobotSimSetTrajectoryCmd_t;
+
+/*
+** Payload attached at the tool frame: mass (kg), centre of mass in the
+** tool frame (m) and inertia about the CoM in tool axes (xx, yy, zz, xy,
+** xz, yz, kg m^2)
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    float Mass;
+    float Com[3];
+    float Inertia[6];
+} RobotSimGrappleCmd_t;
+
+/*
+** Telemetry view: the listed ROBOT_SIM_VIEW_FIELD_* are packed in order
+** into packets on MsgId every RateDivisor HR ticks. A zero divisor or
+** no fields deletes the view. The command may stop after the last field.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8  View;
+    uint8  NumFields;
+    uint16 RateDivisor;
+    uint32 MsgId;
+    uint8  Fields[ROBOT_SIM_VIEW_MAX_FIELDS];
+} RobotSimDefineViewCmd_t;
+
+/*
+** Physics backend. For co-simulation an empty path selects
+** ROBOT_SIM_COSIM_PATH; the backend is only there in host builds.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8 Backend; /**< ROBOT_SIM_PHYSICS_* */
+    uint8 Spare[3];
+    char  SocketPath[OS_MAX_PATH_LEN];
+} RobotSimSetPhysicsCmd_t;
+
+/*
+** Event mode. In quiet mode per-command confirmations are counted in
+** housekeeping instead of sent.
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8 Quiet;
+    uint8 Spare[3];
+} RobotSimSetEventModeCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8 Mode; /**< ROBOT_SIM_MODE_* */
+    uint8 Spare[3];
+} RobotSimSetModeCmd_t;
+
+/*
+** Error model of one joint encoder, see robot_sim_sensor.h
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8 Joint;
+    uint8 Spare[3];
+    float NoiseStdDev;
+    float BiasDriftStdDev;
+    float Quantum;
+    float DropoutProb;
+    uint32 DelaySamples;
+} RobotSimSetSensorCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8 Joint;
+    uint8 Fault; /**< ROBOT_SIM_SENSOR_FAULT_* */
+    uint8 Spare[2];
+    float Value; /**< Output for ROBOT_SIM_SENSOR_FAULT_STUCK_AT */
+} RobotSimSensorFaultCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint32 Seed;
+} RobotSimSensorSeedCmd_t;
+
+/*
+** State recorder window around a trigger, in HR samples
+*/
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint32 PreSamples;
+    uint32 PostSamples;
+} RobotSimRecWindowCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    uint8 Freeze; /**< 1 to freeze, 0 to resume */
+    uint8 Spare[3];
+} RobotSimRecFreezeCmd_t;
+
+typedef struct
+{
+    CFE_MSG_CommandHeader_t CmdHeader; /**< \brief Command header */
+    char Filename[OS_MAX_PATH_LEN];
+} RobotSimRecDumpCmd_t;
+
 /*
 ** The following commands all share the "NoArgs" format
 **
@@ -66,14 +226,16 @@ typedef struct
 ** of the handler function
 */
 typedef RobotSimNoArgsCmd_t RobotSimNoopCmd_t;
+typedef RobotSimNoArgsCmd_t RobotSimStopCmd_t;
+typedef RobotSimNoArgsCmd_t RobotSimReleaseCmd_t;
+typedef RobotSimRecWindowCmd_t RobotSimRecTriggerCmd_t;
+typedef RobotSimRecWindowCmd_t RobotSimRecTrimCmd_t;
 typedef RobotSimJointCmd_t  RobotSimJointStateCmd_t;
 
 /*************************************************************************/
 /*
 ** Type definition (Robot Sim housekeeping)
 */
-#define NUM_JOINTS 7
-
 typedef struct
 {
     uint8 index;
@@ -91,11 +253,59 @@ typedef struct
     float joint6;
 } RobotSimSSRMS_t;
 
+/*
+** Execution statistics of one HR rate group
+*/
+typedef struct
+{
+    uint32 RunCount;
+    uint32 OverrunCount; /**< Runs longer than Divisor HR periods */
+    uint32 LastTimeUsec;
+    uint32 MaxTimeUsec;
+} RobotSimRateGroupTlm_t;
+
+/*
+** Dispatch statistics of one command code
+*/
+typedef struct
+{
+    uint32 AcceptCount;
+    uint32 RejectCount;  /**< Bad length, or refused by the handler */
+    uint32 ExecTimeUsec; /**< Cumulative handler time */
+} RobotSimCmdStatsTlm_t;
+
 typedef struct
 {
     uint8 CommandErrorCounter;
     uint8 CommandCounter;
     RobotSimSSRMS_t state;
+    RobotSimRateGroupTlm_t RateGroups[ROBOT_SIM_MAX_RATE_GROUPS];
+    uint32 CtrlQueueOverflowCount; /**< Control requests dropped on a full queue */
+    uint32 CtrlQueueHighWater;
+    uint32 SensorDropoutCount;
+    uint32 SensorFaultMask; /**< Bit n set if joint n has an injected fault */
+    uint32 RecSequence;     /**< Samples appended to the state recorder */
+    uint32 RecFrozen;
+    uint32 KinHitCount;       /**< Frame queries answered from the cache */
+    uint32 KinMissCount;      /**< Frame queries that recomputed links */
+    uint32 KinRecomputeCount; /**< Link transforms recomputed */
+    uint32 TblLoadTimeUsec;   /**< Time to load and bind the kinematic model */
+    uint32 TblUpdateCount;    /**< Kinematic model updates applied since startup */
+    float  PayloadMass;       /**< Grappled payload mass, 0 when nothing is held */
+    float  VelManipulability; /**< Jacobian manipulability at the last velocity solve */
+    float  VelCondition;      /**< Jacobian condition number at the last velocity solve */
+    float  VelScale;          /**< Singularity slowdown at the last velocity solve */
+    uint32 VelScaledCount;    /**< Velocity solves scaled down near a singularity */
+    uint32 ViewPacketCount;   /**< Telemetry view packets sent */
+    uint32 PhysicsBackend;    /**< ROBOT_SIM_PHYSICS_* in use */
+    uint32 CosimStepCount;    /**< Lockstep ticks completed since the link came up */
+    uint32 CosimFailCount;    /**< Links dropped on a timeout or error */
+    uint32 CosimLastRoundTripUsec;
+    uint32 CosimMaxRoundTripUsec;
+    uint32 EventQuietMode;    /**< 1 while confirmations are counted instead of sent */
+    uint32 EventSuppressedCount; /**< Events dropped for lack of budget */
+    uint32 EventQuietCount;   /**< Confirmations counted in quiet mode */
+    RobotSimCmdStatsTlm_t CmdStats[ROBOT_SIM_NUM_CMD_CODES];
 } RobotSimHkTlmPayload_t;
 
 typedef struct
@@ -104,15 +314,41 @@ typedef struct
     RobotSimHkTlmPayload_t Payload;   /**< \brief Telemetry payload */
 } RobotSimHkTlm_t;
 
+/*
+** Joint controller gains in effect and terms of the last control step
+*/
+typedef struct
+{
+    float Kp[NUM_JOINTS];
+    float Ki[NUM_JOINTS];
+    float Kd[NUM_JOINTS];
+    float P[NUM_JOINTS];
+    float I[NUM_JOINTS]; /**< Integrator state, after anti-windup */
+    float D[NUM_JOINTS];
+    float FF[NUM_JOINTS];
+} RobotSimPidTlm_t;
+
 typedef struct
 {
     CFE_MSG_TelemetryHeader_t  TlmHeader; /**< \brief Telemetry header */
-    RobotSimSSRMS_t joints; /**< Joint states **/
-    float Kp;
+    RobotSimSSRMS_t joints; /**< Measured joint states, after the sensor model **/
+    RobotSimPidTlm_t pid;
     float errors[NUM_JOINTS];
+    float tool[3]; /**< Tool position in the base frame, from the true state */
+    float torque[NUM_JOINTS]; /**< Predicted joint torques, N m */
+    float load[6]; /**< Payload force (N) and moment at the tool point (N m), base frame */
 
 } RobotSimTlmState_t;
 
+/*
+** Telemetry view packet, sized to the fields of its view
+*/
+typedef struct
+{
+    CFE_MSG_TelemetryHeader_t TlmHeader; /**< \brief Telemetry header */
+    uint8 Data[ROBOT_SIM_VIEW_MAX_BYTES];
+} RobotSimViewPkt_t;
+
 #endif /* _robot_sim_msg_h_ */
 
 /************************/
@@ -0,0 +1,316 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_rec.c
+**
+** Purpose:
+**   This file contains the on-board state recorder of the robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_rec.h"
+#include "robot_sim_perfids.h"
+
+#include "cfe_fs.h"
+
+#include <string.h>
+
+typedef char RobotSimRecDepthCheck[((ROBOT_SIM_REC_DEPTH & (ROBOT_SIM_REC_DEPTH - 1)) == 0) ? 1 : -1];
+
+#define ROBOT_SIM_REC_MASK (ROBOT_SIM_REC_DEPTH - 1)
+
+/*
+** Number of samples held in the ring. Sequences wrap at 2^32, so they are
+** only ever compared by their distance back from Head.
+*/
+static uint32 RobotSimRecHeld(const RobotSimRec_t *Rec)
+{
+    return Rec->Full ? ROBOT_SIM_REC_DEPTH : Rec->Head;
+}
+
+/*
+** Write all of Size bytes; a short write is an error
+*/
+static int32 RobotSimRecWrite(osal_id_t Fd, const void *Buffer, size_t Size)
+{
+    int32 status;
+
+    status = OS_write(Fd, Buffer, Size);
+    if (status < 0)
+    {
+        return status;
+    }
+
+    return ((size_t)status == Size) ? OS_SUCCESS : OS_ERROR;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimRecInit() -- empty the ring and start recording                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimRecInit(RobotSimRec_t *Rec)
+{
+    memset(Rec, 0, sizeof(*Rec));
+
+} /* End of RobotSimRecInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimRecAppend() -- record one HR sample                                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimRecAppend(RobotSimRec_t *Rec, const RobotSimModel_t *Model)
+{
+    RobotSimRecRecord_t *Record;
+    CFE_TIME_SysTime_t   Now;
+
+    if (__atomic_load_n(&Rec->Frozen, __ATOMIC_ACQUIRE))
+    {
+        return;
+    }
+
+    Now    = CFE_TIME_GetTime();
+    Record = &Rec->Ring[Rec->Head & ROBOT_SIM_REC_MASK];
+
+    Record->Sequence   = Rec->Head;
+    Record->Seconds    = Now.Seconds;
+    Record->Subseconds = Now.Subseconds;
+    memcpy(Record->Position, Model->Position, sizeof(Record->Position));
+    memcpy(Record->Goal, Model->Goal, sizeof(Record->Goal));
+    memcpy(Record->Error, Model->Error, sizeof(Record->Error));
+
+    Rec->Head++;
+    if ((Rec->Head & ROBOT_SIM_REC_MASK) == 0)
+    {
+        Rec->Full = true;
+    }
+
+    if (Rec->Triggered && Rec->PostRemaining > 0)
+    {
+        Rec->PostRemaining--;
+        if (Rec->PostRemaining == 0)
+        {
+            Rec->WindowEnd = Rec->Head;
+            __atomic_store_n(&Rec->Frozen, 1, __ATOMIC_RELEASE);
+        }
+    }
+
+} /* End of RobotSimRecAppend() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimRecTrigger() -- mark an event, freeze after PostSamples more       */
+/*                                                                            */
+/* Runs in the HR context so that the trigger lands on a tick boundary.       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimRecTrigger(RobotSimRec_t *Rec, uint32 PreSamples, uint32 PostSamples)
+{
+    uint32 Held;
+
+    if (PostSamples > ROBOT_SIM_REC_DEPTH)
+    {
+        PostSamples = ROBOT_SIM_REC_DEPTH;
+    }
+    if (PreSamples > ROBOT_SIM_REC_DEPTH - PostSamples)
+    {
+        PreSamples = ROBOT_SIM_REC_DEPTH - PostSamples;
+    }
+
+    /*
+    ** With PreSamples clipped as above, the post-trigger samples cannot
+    ** overwrite the pre-trigger ones; only those not yet recorded are lost
+    */
+    Held = RobotSimRecHeld(Rec);
+
+    Rec->Triggered     = true;
+    Rec->TriggerSeq    = Rec->Head;
+    Rec->PostRemaining = PostSamples;
+    Rec->WindowStart   = Rec->Head - ((Held > PreSamples) ? PreSamples : Held);
+    Rec->WindowEnd     = Rec->Head;
+
+    if (PostSamples == 0)
+    {
+        __atomic_store_n(&Rec->Frozen, 1, __ATOMIC_RELEASE);
+    }
+
+} /* End of RobotSimRecTrigger() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimRecFreeze() -- stop or resume recording                            */
+/*                                                                            */
+/* Resuming discards any trigger window.                                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimRecFreeze(RobotSimRec_t *Rec, bool Freeze)
+{
+    if (Freeze)
+    {
+        __atomic_store_n(&Rec->Frozen, 1, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        Rec->Triggered     = false;
+        Rec->PostRemaining = 0;
+        __atomic_store_n(&Rec->Frozen, 0, __ATOMIC_RELEASE);
+    }
+
+} /* End of RobotSimRecFreeze() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimRecTrim() -- narrow the dump window of a frozen recorder           */
+/*                                                                            */
+/* The window is centred on the trigger, or on the newest sample if there     */
+/* was no trigger.                                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimRecTrim(RobotSimRec_t *Rec, uint32 PreSamples, uint32 PostSamples)
+{
+    uint32 Held;
+    uint32 Ref;
+    uint32 After;
+
+    if (!__atomic_load_n(&Rec->Frozen, __ATOMIC_ACQUIRE))
+    {
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Held  = RobotSimRecHeld(Rec);
+    Ref   = Rec->Triggered ? Rec->TriggerSeq : Rec->Head;
+    After = Rec->Head - Ref;
+
+    Rec->WindowStart = (After < Held && Held - After > PreSamples) ? (Ref - PreSamples) : (Rec->Head - Held);
+    Rec->WindowEnd   = (After > PostSamples) ? (Ref + PostSamples) : Rec->Head;
+    Rec->Triggered   = true;
+    Rec->TriggerSeq  = Ref;
+
+    return CFE_SUCCESS;
+
+} /* End of RobotSimRecTrim() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimRecDump() -- write the window of a frozen recorder to a file       */
+/*                                                                            */
+/* Writes the whole ring when no window is set. The ring wraps at most once   */
+/* inside a window, so the samples go out in at most two writes. A write      */
+/* that fails or comes up short fails the dump.                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimRecDump(RobotSimRec_t *Rec, const char *Filename, uint32 *NumRecords)
+{
+    CFE_FS_Header_t      FsHdr;
+    RobotSimRecFileHdr_t RecHdr;
+    osal_id_t            Fd;
+    uint32               Held;
+    uint32               Start;
+    uint32               End;
+    uint32               Count;
+    uint32               First;
+    int32                status;
+
+    *NumRecords = 0;
+
+    if (!__atomic_load_n(&Rec->Frozen, __ATOMIC_ACQUIRE))
+    {
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Held  = RobotSimRecHeld(Rec);
+    Start = Rec->Head - Held;
+    End   = Rec->Head;
+    if (Rec->Triggered)
+    {
+        if (Rec->Head - Rec->WindowStart < Held)
+        {
+            Start = Rec->WindowStart;
+        }
+        End = Rec->WindowEnd;
+    }
+    Count = (Rec->Head - Start > Rec->Head - End) ? (End - Start) : 0;
+
+    status = OS_OpenCreate(&Fd, Filename, OS_FILE_FLAG_CREATE | OS_FILE_FLAG_TRUNCATE, OS_WRITE_ONLY);
+    if (status != OS_SUCCESS)
+    {
+        return status;
+    }
+
+    CFE_ES_PerfLogEntry(ROBOT_SIM_REC_DUMP_PERF_ID);
+
+    CFE_FS_InitHeader(&FsHdr, "Robot Sim state recording", ROBOT_SIM_REC_FS_SUBTYPE);
+    status = CFE_FS_WriteHeader(Fd, &FsHdr);
+    if (status == sizeof(FsHdr))
+    {
+        memset(&RecHdr, 0, sizeof(RecHdr));
+        RecHdr.Magic         = ROBOT_SIM_REC_MAGIC;
+        RecHdr.Version       = ROBOT_SIM_REC_VERSION;
+        RecHdr.NumJoints     = NUM_JOINTS;
+        RecHdr.RecordSize    = sizeof(RobotSimRecRecord_t);
+        RecHdr.NumRecords    = Count;
+        RecHdr.FirstSequence = Start;
+        RecHdr.TriggerIndex  = (Rec->Triggered && Rec->TriggerSeq - Start < Count) ? (Rec->TriggerSeq - Start)
+                                                                                      : ROBOT_SIM_REC_NO_TRIGGER;
+
+        status = RobotSimRecWrite(Fd, &RecHdr, sizeof(RecHdr));
+    }
+    else if (status >= 0)
+    {
+        status = OS_ERROR;
+    }
+
+    if (status == OS_SUCCESS && Count > 0)
+    {
+        First = Start & ROBOT_SIM_REC_MASK;
+        if (First + Count > ROBOT_SIM_REC_DEPTH)
+        {
+            status = RobotSimRecWrite(Fd, &Rec->Ring[First],
+                                      sizeof(RobotSimRecRecord_t) * (ROBOT_SIM_REC_DEPTH - First));
+            if (status == OS_SUCCESS)
+            {
+                status = RobotSimRecWrite(Fd, &Rec->Ring[0],
+                                          sizeof(RobotSimRecRecord_t) * (First + Count - ROBOT_SIM_REC_DEPTH));
+            }
+        }
+        else
+        {
+            status = RobotSimRecWrite(Fd, &Rec->Ring[First], sizeof(RobotSimRecRecord_t) * Count);
+        }
+    }
+
+    CFE_ES_PerfLogExit(ROBOT_SIM_REC_DUMP_PERF_ID);
+
+    OS_close(Fd);
+
+    if (status != OS_SUCCESS)
+    {
+        return status;
+    }
+
+    *NumRecords = Count;
+
+    return CFE_SUCCESS;
+
+} /* End of RobotSimRecDump() */
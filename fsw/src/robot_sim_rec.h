@@ -0,0 +1,72 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_rec.h
+**
+** Purpose:
+**   On-board recorder of HR state samples.
+**
+** Notes:
+**   Samples are appended to a preallocated ring in RAM with no system
+**   calls; files are only written when a window is dumped by command.
+**   Sequence numbers count every sample ever appended, the ring holds the
+**   last ROBOT_SIM_REC_DEPTH of them.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_rec_h_
+#define _robot_sim_rec_h_
+
+#include "cfe.h"
+
+#include "robot_sim_model.h"
+#include "robot_sim_platform_cfg.h"
+#include "robot_sim_rec_format.h"
+
+typedef struct
+{
+    uint32 Head;   /**< Sequence of the next sample, wraps at 2^32 */
+    uint32 Frozen; /**< Appends are ignored while set */
+    bool   Full;   /**< Every slot of the ring holds a sample */
+
+    /*
+    ** Trigger window, in sequence numbers [WindowStart, WindowEnd)
+    */
+    bool   Triggered;
+    uint32 TriggerSeq;
+    uint32 PostRemaining; /**< Samples still to record before freezing */
+    uint32 WindowStart;
+    uint32 WindowEnd;
+
+    RobotSimRecRecord_t Ring[ROBOT_SIM_REC_DEPTH];
+} RobotSimRec_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void  RobotSimRecInit(RobotSimRec_t *Rec);
+void  RobotSimRecAppend(RobotSimRec_t *Rec, const RobotSimModel_t *Model);
+void  RobotSimRecTrigger(RobotSimRec_t *Rec, uint32 PreSamples, uint32 PostSamples);
+void  RobotSimRecFreeze(RobotSimRec_t *Rec, bool Freeze);
+int32 RobotSimRecTrim(RobotSimRec_t *Rec, uint32 PreSamples, uint32 PostSamples);
+int32 RobotSimRecDump(RobotSimRec_t *Rec, const char *Filename, uint32 *NumRecords);
+
+#endif /* _robot_sim_rec_h_ */
@@ -0,0 +1,141 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_sched.c
+**
+** Purpose:
+**   This file contains the rate-group scheduler of the robot sim. Stages
+**   run at integer divisors of the HR wakeup rate, in registration order.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_sched.h"
+#include "robot_sim_platform_cfg.h"
+
+#include <string.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSchedInit() -- clear all rate groups                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimSchedInit(RobotSimSched_t *Sched)
+{
+    memset(Sched, 0, sizeof(*Sched));
+
+} /* End of RobotSimSchedInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSchedRegister() -- add a stage to the schedule                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+int32 RobotSimSchedRegister(RobotSimSched_t *Sched, RobotSimStageFunc_t Func, uint16 Divisor, uint16 Phase,
+                            uint32 PerfId)
+{
+    RobotSimRateGroup_t *Group;
+
+    if (Func == NULL || Divisor == 0 || Phase >= Divisor || Sched->NumGroups >= ROBOT_SIM_MAX_RATE_GROUPS)
+    {
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    Group             = &Sched->Groups[Sched->NumGroups];
+    Group->Func       = Func;
+    Group->PerfId     = PerfId;
+    Group->Divisor    = Divisor;
+    Group->Phase      = Phase;
+    Group->BudgetUsec = (uint32)Divisor * ROBOT_SIM_HR_PERIOD_USEC;
+    memset(&Group->Stats, 0, sizeof(Group->Stats));
+
+    Sched->NumGroups++;
+
+    return CFE_SUCCESS;
+
+} /* End of RobotSimSchedRegister() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSchedTick() -- run the stages due on this HR wakeup                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimSchedTick(RobotSimSched_t *Sched)
+{
+    RobotSimRateGroup_t *Group;
+    OS_time_t            Start;
+    OS_time_t            Stop;
+    uint32               ElapsedUsec;
+    uint16               i;
+
+    for (i = 0; i < Sched->NumGroups; i++)
+    {
+        Group = &Sched->Groups[i];
+
+        if ((Sched->Tick % Group->Divisor) != Group->Phase)
+        {
+            continue;
+        }
+
+        CFE_ES_PerfLogEntry(Group->PerfId);
+        CFE_PSP_GetTime(&Start);
+
+        Group->Func();
+
+        CFE_PSP_GetTime(&Stop);
+        CFE_ES_PerfLogExit(Group->PerfId);
+
+        ElapsedUsec = (uint32)OS_TimeGetTotalMicroseconds(OS_TimeSubtract(Stop, Start));
+
+        Group->Stats.RunCount++;
+        Group->Stats.LastTimeUsec = ElapsedUsec;
+        if (ElapsedUsec > Group->Stats.MaxTimeUsec)
+        {
+            Group->Stats.MaxTimeUsec = ElapsedUsec;
+        }
+        if (ElapsedUsec > Group->BudgetUsec)
+        {
+            Group->Stats.OverrunCount++;
+        }
+    }
+
+    Sched->Tick++;
+
+} /* End of RobotSimSchedTick() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSchedReport() -- copy rate-group statistics for housekeeping       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimSchedReport(const RobotSimSched_t *Sched, RobotSimRateGroupTlm_t *Tlm)
+{
+    uint16 i;
+
+    memset(Tlm, 0, sizeof(RobotSimRateGroupTlm_t) * ROBOT_SIM_MAX_RATE_GROUPS);
+
+    for (i = 0; i < Sched->NumGroups; i++)
+    {
+        Tlm[i] = Sched->Groups[i].Stats;
+    }
+
+} /* End of RobotSimSchedReport() */
@@ -0,0 +1,68 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_sched.h
+**
+** Purpose:
+**   Rate-group scheduler driven by the HR wakeup.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_sched_h_
+#define _robot_sim_sched_h_
+
+#include "cfe.h"
+
+#include "robot_sim_msg.h"
+
+typedef void (*RobotSimStageFunc_t)(void);
+
+/*
+** One registered stage
+*/
+typedef struct
+{
+    RobotSimStageFunc_t Func;
+    uint32              PerfId;
+    uint16              Divisor;
+    uint16              Phase;
+    uint32              BudgetUsec; /**< Divisor times the HR period */
+
+    RobotSimRateGroupTlm_t Stats;
+} RobotSimRateGroup_t;
+
+typedef struct
+{
+    uint32              Tick;
+    uint16              NumGroups;
+    RobotSimRateGroup_t Groups[ROBOT_SIM_MAX_RATE_GROUPS];
+} RobotSimSched_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void  RobotSimSchedInit(RobotSimSched_t *Sched);
+int32 RobotSimSchedRegister(RobotSimSched_t *Sched, RobotSimStageFunc_t Func, uint16 Divisor, uint16 Phase,
+                            uint32 PerfId);
+void  RobotSimSchedTick(RobotSimSched_t *Sched);
+void  RobotSimSchedReport(const RobotSimSched_t *Sched, RobotSimRateGroupTlm_t *Tlm);
+
+#endif /* _robot_sim_sched_h_ */
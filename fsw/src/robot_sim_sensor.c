@@ -0,0 +1,251 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_sensor.c
+**
+** Purpose:
+**   This file contains the joint encoder model of the robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_sensor.h"
+
+#include <math.h>
+#include <string.h>
+
+typedef char RobotSimSensorDelayCheck[((ROBOT_SIM_SENSOR_MAX_DELAY & (ROBOT_SIM_SENSOR_MAX_DELAY - 1)) == 0) ? 1 : -1];
+
+#define ROBOT_SIM_SENSOR_DELAY_MASK (ROBOT_SIM_SENSOR_MAX_DELAY - 1)
+
+/*
+** Scales the sum of four uniforms to unit variance
+*/
+#define ROBOT_SIM_SENSOR_GAUSS_SCALE 1.7320508f
+
+/*
+** One xoshiro128+ step of a single stream held in registers, returning a
+** uniform deviate in [0, 1)
+*/
+#define ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u)                          \
+    do                                                                    \
+    {                                                                     \
+        uint32_t t_ = (s1) << 9;                                          \
+        (u)         = (float)(((s0) + (s3)) >> 8) * (1.0f / 16777216.0f); \
+        (s2) ^= (s0);                                                     \
+        (s3) ^= (s1);                                                     \
+        (s1) ^= (s2);                                                     \
+        (s0) ^= (s3);                                                     \
+        (s2) ^= t_;                                                       \
+        (s3) = ((s3) << 11) | ((s3) >> 21);                               \
+    } while (0)
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSensorDraw() -- random deviates for one sample of every joint      */
+/*                                                                            */
+/* Each joint has its own stream, so the loop body is independent across      */
+/* joints and vectorizes. Normal deviates use the sum of four uniforms        */
+/* (Irwin-Hall), which is branch-free; tails are truncated at about 3.5       */
+/* sigma.                                                                     */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void RobotSimSensorDraw(RobotSimSensor_t *Sensor, float *Noise, float *Drift, float *Drop)
+{
+    uint32_t s0, s1, s2, s3;
+    float    u0, u1, u2, u3;
+    int      j;
+
+    for (j = 0; j < ROBOT_SIM_SENSOR_LANES; j++)
+    {
+        s0 = Sensor->Rng0[j];
+        s1 = Sensor->Rng1[j];
+        s2 = Sensor->Rng2[j];
+        s3 = Sensor->Rng3[j];
+
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u0);
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u1);
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u2);
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u3);
+        Noise[j] = (u0 + u1 + u2 + u3 - 2.0f) * ROBOT_SIM_SENSOR_GAUSS_SCALE;
+
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u0);
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u1);
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u2);
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, u3);
+        Drift[j] = (u0 + u1 + u2 + u3 - 2.0f) * ROBOT_SIM_SENSOR_GAUSS_SCALE;
+
+        ROBOT_SIM_SENSOR_NEXT(s0, s1, s2, s3, Drop[j]);
+
+        Sensor->Rng0[j] = s0;
+        Sensor->Rng1[j] = s1;
+        Sensor->Rng2[j] = s2;
+        Sensor->Rng3[j] = s3;
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSensorInit() -- ideal sensor, no faults                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimSensorInit(RobotSimSensor_t *Sensor, uint32_t Seed)
+{
+    memset(Sensor, 0, sizeof(*Sensor));
+    RobotSimSensorSeed(Sensor, Seed);
+
+} /* End of RobotSimSensorInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSensorSeed() -- restart the random streams and all sample history  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimSensorSeed(RobotSimSensor_t *Sensor, uint32_t Seed)
+{
+    uint32_t *Lanes[4];
+    uint32_t  z;
+    int       k;
+    int       j;
+
+    Lanes[0] = Sensor->Rng0;
+    Lanes[1] = Sensor->Rng1;
+    Lanes[2] = Sensor->Rng2;
+    Lanes[3] = Sensor->Rng3;
+
+    /*
+    ** Expand the seed with a 32-bit splitmix so no lane starts all-zero
+    */
+    for (j = 0; j < ROBOT_SIM_SENSOR_LANES; j++)
+    {
+        for (k = 0; k < 4; k++)
+        {
+            Seed += 0x9E3779B9u;
+            z = Seed;
+            z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+            z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+            z = z ^ (z >> 16);
+
+            Lanes[k][j] = (z != 0) ? z : 1;
+        }
+    }
+
+    /*
+    ** Same seed, same samples: nothing from before the reseed may leak out
+    ** through the delay line or a held (dropped or stuck) output. Both are
+    ** primed from the true angles at the next sample, not left at zero.
+    */
+    memset(Sensor->Bias, 0, sizeof(Sensor->Bias));
+    Sensor->Primed       = 0;
+    Sensor->DelayHead    = 0;
+    Sensor->DropoutCount = 0;
+
+} /* End of RobotSimSensorSeed() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSensorSetFault() -- inject or clear a joint fault                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimSensorSetFault(RobotSimSensor_t *Sensor, uint32_t Joint, uint32_t Fault, float Value)
+{
+    if (Joint < NUM_JOINTS)
+    {
+        Sensor->Fault[Joint]      = Fault;
+        Sensor->FaultValue[Joint] = Value;
+    }
+
+} /* End of RobotSimSensorSetFault() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimSensorSample() -- produce one measured sample of every joint       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimSensorSample(RobotSimSensor_t *Sensor, const float *Truth, float *Measured)
+{
+    const RobotSimSensorConfig_t *Config = &Sensor->Config;
+    float                         Noise[ROBOT_SIM_SENSOR_LANES];
+    float                         Drift[ROBOT_SIM_SENSOR_LANES];
+    float                         Drop[ROBOT_SIM_SENSOR_LANES];
+    float                        *Slot;
+    float                         Value;
+    uint32_t                      Newest;
+    int                           k;
+    int                           j;
+
+    RobotSimSensorDraw(Sensor, Noise, Drift, Drop);
+
+    /*
+    ** First sample since a (re)seed: a delayed, dropped or stuck output
+    ** reads the arm as it is now rather than 0 rad
+    */
+    if (!Sensor->Primed)
+    {
+        for (k = 0; k < ROBOT_SIM_SENSOR_MAX_DELAY; k++)
+        {
+            memcpy(Sensor->DelayLine[k], Truth, sizeof(Sensor->DelayLine[k]));
+        }
+        memcpy(Sensor->Output, Truth, sizeof(Sensor->Output));
+        Sensor->Primed = 1;
+    }
+
+    Newest = Sensor->DelayHead & ROBOT_SIM_SENSOR_DELAY_MASK;
+    Slot   = Sensor->DelayLine[Newest];
+
+    for (j = 0; j < NUM_JOINTS; j++)
+    {
+        Sensor->Bias[j] += Config->BiasDriftStdDev[j] * Drift[j];
+
+        Value = Truth[j] + Sensor->Bias[j] + Config->NoiseStdDev[j] * Noise[j];
+        if (Config->Quantum[j] > 0.0f)
+        {
+            Value = Config->Quantum[j] * floorf(Value / Config->Quantum[j] + 0.5f);
+        }
+
+        Slot[j] = Value;
+    }
+
+    for (j = 0; j < NUM_JOINTS; j++)
+    {
+        Value = Sensor->DelayLine[(Newest - Config->DelaySamples[j]) & ROBOT_SIM_SENSOR_DELAY_MASK][j];
+
+        if (Drop[j] < Config->DropoutProb[j])
+        {
+            Sensor->DropoutCount++;
+        }
+        else if (Sensor->Fault[j] == ROBOT_SIM_SENSOR_FAULT_NONE)
+        {
+            Sensor->Output[j] = Value;
+        }
+
+        if (Sensor->Fault[j] == ROBOT_SIM_SENSOR_FAULT_STUCK_AT)
+        {
+            Sensor->Output[j] = Sensor->FaultValue[j];
+        }
+
+        Measured[j] = Sensor->Output[j];
+    }
+
+    Sensor->DelayHead++;
+
+} /* End of RobotSimSensorSample() */
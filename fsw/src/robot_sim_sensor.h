@@ -0,0 +1,99 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_sensor.h
+**
+** Purpose:
+**   Joint encoder model: noise, bias drift, quantization, latency,
+**   dropouts and stuck-at faults applied to the true joint angles.
+**
+** Notes:
+**   All per-joint data is stored as arrays indexed by joint so the sample
+**   loop vectorizes. Like the model core, this module has no cFE/OSAL
+**   dependency.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_sensor_h_
+#define _robot_sim_sensor_h_
+
+#include "robot_sim_mission_cfg.h"
+#include "robot_sim_platform_cfg.h"
+
+#include <stdint.h>
+
+/*
+** Random streams are padded to a multiple of the SIMD width
+*/
+#define ROBOT_SIM_SENSOR_LANES ((NUM_JOINTS + 7) & ~7)
+
+/*
+** Sensor fault types
+*/
+#define ROBOT_SIM_SENSOR_FAULT_NONE     0
+#define ROBOT_SIM_SENSOR_FAULT_STUCK    1 /**< Output freezes at its last value */
+#define ROBOT_SIM_SENSOR_FAULT_STUCK_AT 2 /**< Output forced to a commanded value */
+
+/*
+** Per-joint error model parameters
+*/
+typedef struct
+{
+    float    NoiseStdDev[NUM_JOINTS];     /**< White noise, rad */
+    float    BiasDriftStdDev[NUM_JOINTS]; /**< Random walk step per sample, rad */
+    float    Quantum[NUM_JOINTS];         /**< Encoder resolution, rad (0 disables) */
+    float    DropoutProb[NUM_JOINTS];     /**< Chance a sample is lost and the last one repeated */
+    uint32_t DelaySamples[NUM_JOINTS];    /**< Latency, < ROBOT_SIM_SENSOR_MAX_DELAY */
+} RobotSimSensorConfig_t;
+
+typedef struct
+{
+    RobotSimSensorConfig_t Config;
+
+    /*
+    ** xoshiro128+ state, one independent stream per joint
+    */
+    uint32_t Rng0[ROBOT_SIM_SENSOR_LANES];
+    uint32_t Rng1[ROBOT_SIM_SENSOR_LANES];
+    uint32_t Rng2[ROBOT_SIM_SENSOR_LANES];
+    uint32_t Rng3[ROBOT_SIM_SENSOR_LANES];
+
+    float    Bias[NUM_JOINTS];
+    float    Output[NUM_JOINTS];
+    uint32_t Fault[NUM_JOINTS];
+    float    FaultValue[NUM_JOINTS];
+
+    uint32_t Primed; /**< Delay line and output hold real angles, set by the first sample after a seed */
+    uint32_t DelayHead;
+    float    DelayLine[ROBOT_SIM_SENSOR_MAX_DELAY][NUM_JOINTS];
+
+    uint32_t DropoutCount;
+} RobotSimSensor_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void RobotSimSensorInit(RobotSimSensor_t *Sensor, uint32_t Seed);
+void RobotSimSensorSeed(RobotSimSensor_t *Sensor, uint32_t Seed);
+void RobotSimSensorSetFault(RobotSimSensor_t *Sensor, uint32_t Joint, uint32_t Fault, float Value);
+void RobotSimSensorSample(RobotSimSensor_t *Sensor, const float *Truth, float *Measured);
+
+#endif /* _robot_sim_sensor_h_ */
@@ -0,0 +1,306 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_vel.c
+**
+** Purpose:
+**   This file contains the resolved-rate velocity control of the robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_vel.h"
+
+#include <math.h>
+#include <string.h>
+
+/*
+** Cyclic Jacobi sweeps on the 6x6 J*J'; it converges in 4-6 from scratch
+** and in 1-2 from the previous tick's eigenvectors
+*/
+#define ROBOT_SIM_VEL_MAX_SWEEPS 10
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimVelEigen() -- eigen-decompose a symmetric 6x6 matrix in place      */
+/*                                                                            */
+/* V holds an initial orthonormal guess on entry. On return the diagonal of  */
+/* A holds the eigenvalues of V' * A * V and the columns of V the matching    */
+/* eigenvectors of the original A.                                            */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void RobotSimVelEigen(double A[6][6], double V[6][6])
+{
+    double Off;
+    double Diag;
+    double Theta;
+    double t;
+    double c;
+    double s;
+    double Apk;
+    double Aqk;
+    double T[6][6];
+    int    Sweep;
+    int    p;
+    int    q;
+    int    k;
+
+    /*
+    ** A = V' * A * V, so the sweeps start from the rotated, nearly diagonal
+    ** matrix and keep accumulating into V
+    */
+    for (p = 0; p < 6; p++)
+    {
+        for (q = 0; q < 6; q++)
+        {
+            T[p][q] = A[p][0] * V[0][q] + A[p][1] * V[1][q] + A[p][2] * V[2][q] + A[p][3] * V[3][q] +
+                      A[p][4] * V[4][q] + A[p][5] * V[5][q];
+        }
+    }
+    for (p = 0; p < 6; p++)
+    {
+        for (q = p; q < 6; q++)
+        {
+            A[p][q] = V[0][p] * T[0][q] + V[1][p] * T[1][q] + V[2][p] * T[2][q] + V[3][p] * T[3][q] +
+                      V[4][p] * T[4][q] + V[5][p] * T[5][q];
+            A[q][p] = A[p][q];
+        }
+    }
+
+    for (Sweep = 0; Sweep < ROBOT_SIM_VEL_MAX_SWEEPS; Sweep++)
+    {
+        Off  = 0.0;
+        Diag = 0.0;
+        for (p = 0; p < 6; p++)
+        {
+            Diag += A[p][p] * A[p][p];
+            for (q = p + 1; q < 6; q++)
+            {
+                Off += A[p][q] * A[p][q];
+            }
+        }
+        if (Off <= 1.0e-24 * Diag)
+        {
+            break;
+        }
+
+        for (p = 0; p < 5; p++)
+        {
+            for (q = p + 1; q < 6; q++)
+            {
+                if (A[p][q] == 0.0)
+                {
+                    continue;
+                }
+
+                Theta = (A[q][q] - A[p][p]) / (2.0 * A[p][q]);
+                t     = 1.0 / (fabs(Theta) + sqrt(Theta * Theta + 1.0));
+                if (Theta < 0.0)
+                {
+                    t = -t;
+                }
+                c = 1.0 / sqrt(t * t + 1.0);
+                s = t * c;
+
+                for (k = 0; k < 6; k++)
+                {
+                    Apk     = A[p][k];
+                    Aqk     = A[q][k];
+                    A[p][k] = c * Apk - s * Aqk;
+                    A[q][k] = s * Apk + c * Aqk;
+                }
+                for (k = 0; k < 6; k++)
+                {
+                    Apk     = A[k][p];
+                    Aqk     = A[k][q];
+                    A[k][p] = c * Apk - s * Aqk;
+                    A[k][q] = s * Apk + c * Aqk;
+                }
+                for (k = 0; k < 6; k++)
+                {
+                    Apk     = V[k][p];
+                    Aqk     = V[k][q];
+                    V[k][p] = c * Apk - s * Aqk;
+                    V[k][q] = s * Apk + c * Aqk;
+                }
+            }
+        }
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimVelInit() -- no twist commanded, arm at rest                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimVelInit(RobotSimVel_t *Vel, const RobotSimVelConfig_t *Config)
+{
+    int k;
+
+    memset(Vel, 0, sizeof(*Vel));
+    Vel->Config = *Config;
+    Vel->Scale  = 1.0f;
+
+    for (k = 0; k < 6; k++)
+    {
+        Vel->Basis[k][k] = 1.0;
+    }
+
+} /* End of RobotSimVelInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimVelSetTwist() -- set the commanded tool twist                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimVelSetTwist(RobotSimVel_t *Vel, const float *Twist)
+{
+    memcpy(Vel->Twist, Twist, sizeof(Vel->Twist));
+
+} /* End of RobotSimVelSetTwist() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimVelSolve() -- joint rates for the commanded twist                  */
+/*                                                                            */
+/* Rate = Scale * J' * V * diag(1 / (e + lambda^2)) * V' * Twist, where       */
+/* J*J' = V * diag(e) * V'. Scale falls linearly from 1 at CondSlow to 0 at   */
+/* CondStop; the damping keeps the rates bounded in between.                  */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimVelSolve(RobotSimVel_t *Vel, RobotSimKin_t *Kin)
+{
+    const RobotSimVelConfig_t *Config = &Vel->Config;
+    float                      J[6][NUM_JOINTS];
+    double                     A[6][6];
+    double (*V)[6]             = Vel->Basis;
+    double                     Twist[6];
+    double                     y[6];
+    double                     x[6];
+    double                     Det = 1.0;
+    double                     EigMin;
+    double                     EigMax;
+    double                     Sum;
+    float                      Cond;
+    int                        i;
+    int                        k;
+    int                        m;
+
+    RobotSimKinJacobian(Kin, J);
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        J[3][i] *= Config->LengthScale;
+        J[4][i] *= Config->LengthScale;
+        J[5][i] *= Config->LengthScale;
+    }
+
+    for (k = 0; k < 6; k++)
+    {
+        for (m = k; m < 6; m++)
+        {
+            Sum = 0.0;
+            for (i = 0; i < NUM_JOINTS; i++)
+            {
+                Sum += (double)J[k][i] * (double)J[m][i];
+            }
+            A[k][m] = Sum;
+            A[m][k] = Sum;
+        }
+    }
+
+    RobotSimVelEigen(A, V);
+
+    EigMin = A[0][0];
+    EigMax = A[0][0];
+    for (k = 0; k < 6; k++)
+    {
+        if (A[k][k] < 0.0)
+        {
+            A[k][k] = 0.0;
+        }
+        EigMin = (A[k][k] < EigMin) ? A[k][k] : EigMin;
+        EigMax = (A[k][k] > EigMax) ? A[k][k] : EigMax;
+        Det *= A[k][k];
+    }
+
+    /*
+    ** Weighting the angular rows by L scales det(J*J') by L^6
+    */
+    Vel->Manipulability = (float)(sqrt(Det) / ((double)Config->LengthScale * Config->LengthScale * Config->LengthScale));
+    Vel->Condition      = (EigMin > 0.0) ? (float)sqrt(EigMax / EigMin) : HUGE_VALF;
+
+    Cond = Vel->Condition;
+    if (Cond <= Config->CondSlow)
+    {
+        Vel->Scale = 1.0f;
+    }
+    else if (Cond >= Config->CondStop)
+    {
+        Vel->Scale = 0.0f;
+    }
+    else
+    {
+        Vel->Scale = (Config->CondStop - Cond) / (Config->CondStop - Config->CondSlow);
+    }
+
+    Vel->SolveCount++;
+    if (Vel->Scale < 1.0f)
+    {
+        Vel->ScaledCount++;
+    }
+
+    for (k = 0; k < 3; k++)
+    {
+        Twist[k]     = Vel->Twist[k];
+        Twist[k + 3] = (double)Vel->Twist[k + 3] * Config->LengthScale;
+    }
+
+    for (k = 0; k < 6; k++)
+    {
+        Sum = 0.0;
+        for (m = 0; m < 6; m++)
+        {
+            Sum += V[m][k] * Twist[m];
+        }
+        y[k] = Sum / (A[k][k] + Config->Damping);
+    }
+    for (k = 0; k < 6; k++)
+    {
+        Sum = 0.0;
+        for (m = 0; m < 6; m++)
+        {
+            Sum += V[k][m] * y[m];
+        }
+        x[k] = Sum * Vel->Scale;
+    }
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Sum = 0.0;
+        for (k = 0; k < 6; k++)
+        {
+            Sum += (double)J[k][i] * x[k];
+        }
+        Vel->Rate[i] = (float)Sum;
+    }
+
+} /* End of RobotSimVelSolve() */
@@ -0,0 +1,77 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_vel.h
+**
+** Purpose:
+**   Resolved-rate control: maps a commanded tool twist to joint rates
+**   through the arm Jacobian and slows the arm near singularities.
+**
+** Notes:
+**   The solve is damped least squares on an eigen-decomposition of
+**   J*J', which also yields the manipulability and condition number.
+**   Angular rows are weighted by a characteristic length so the
+**   condition number compares like units. Like the model core, this
+**   module has no cFE/OSAL dependency.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_vel_h_
+#define _robot_sim_vel_h_
+
+#include "robot_sim_mission_cfg.h"
+#include "robot_sim_kin.h"
+
+#include <stdint.h>
+
+typedef struct
+{
+    float LengthScale; /**< Metres per radian used to weight the angular rows */
+    float Damping;     /**< Damped least squares lambda^2, weighted units */
+    float CondSlow;    /**< Condition number where commands start to be scaled down */
+    float CondStop;    /**< Condition number where commands reach zero */
+} RobotSimVelConfig_t;
+
+typedef struct
+{
+    RobotSimVelConfig_t Config;
+
+    float Twist[6];          /**< Commanded tool twist, world frame: m/s then rad/s */
+    float Rate[NUM_JOINTS];  /**< Joint rates from the last solve, rad/s */
+
+    float Manipulability; /**< sqrt(det(J*J')), unweighted */
+    float Condition;      /**< Largest over smallest singular value, weighted */
+    float Scale;          /**< Singularity slowdown applied on the last solve, 0..1 */
+
+    double Basis[6][6]; /**< Eigenvectors from the last solve, warm start for the next */
+
+    uint32_t SolveCount;  /**< Solves run */
+    uint32_t ScaledCount; /**< Solves where the command was scaled down */
+} RobotSimVel_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void RobotSimVelInit(RobotSimVel_t *Vel, const RobotSimVelConfig_t *Config);
+void RobotSimVelSetTwist(RobotSimVel_t *Vel, const float *Twist);
+void RobotSimVelSolve(RobotSimVel_t *Vel, RobotSimKin_t *Kin);
+
+#endif /* _robot_sim_vel_h_ */
@@ -0,0 +1,161 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_view.c
+**
+** Purpose:
+**   This file contains the telemetry view compiler and packer of the
+**   robot sim.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_view.h"
+
+#include <string.h>
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimViewInit() -- an undefined view                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+void RobotSimViewInit(RobotSimView_t *View)
+{
+    memset(View, 0, sizeof(*View));
+
+} /* End of RobotSimViewInit() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimViewCompile() -- resolve a field list into a copy plan             */
+/*                                                                            */
+/* A zero rate divisor or an empty list undefines the view. On any error     */
+/* the view is left as it was.                                               */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RobotSimViewCompile(RobotSimView_t *View, const RobotSimViewField_t *Catalog, const uint8_t *Fields,
+                         uint32_t NumFields, uint16_t RateDivisor)
+{
+    RobotSimView_t             New;
+    const RobotSimViewField_t *Field;
+    const RobotSimViewCopy_t  *Segment;
+    RobotSimViewCopy_t        *Last;
+    uint32_t                   i;
+    uint32_t                   k;
+
+    if (NumFields > ROBOT_SIM_VIEW_MAX_FIELDS)
+    {
+        return false;
+    }
+
+    RobotSimViewInit(&New);
+
+    if (RateDivisor != 0 && NumFields != 0)
+    {
+        New.RateDivisor = RateDivisor;
+        New.Countdown   = 1;
+
+        for (i = 0; i < NumFields; i++)
+        {
+            if (Fields[i] == 0 || Fields[i] >= ROBOT_SIM_VIEW_FIELD_COUNT)
+            {
+                return false;
+            }
+
+            Field = &Catalog[Fields[i]];
+            if (Field->NumSegments == 0)
+            {
+                return false;
+            }
+
+            New.FieldMask |= 1u << Fields[i];
+
+            for (k = 0; k < Field->NumSegments; k++)
+            {
+                Segment = &Field->Segment[k];
+                if (New.Size + Segment->Length > ROBOT_SIM_VIEW_MAX_BYTES)
+                {
+                    return false;
+                }
+                New.Size += (uint32_t)Segment->Length;
+
+                /*
+                ** Output is packed, so a segment that starts where the
+                ** last one ended extends the last copy
+                */
+                Last = New.NumCopies > 0 ? &New.Plan[New.NumCopies - 1] : NULL;
+                if (Last != NULL && (const uint8_t *)Last->Src + Last->Length == Segment->Src)
+                {
+                    Last->Length += Segment->Length;
+                }
+                else
+                {
+                    New.Plan[New.NumCopies++] = *Segment;
+                }
+            }
+        }
+    }
+
+    *View = New;
+
+    return true;
+
+} /* End of RobotSimViewCompile() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimViewDue() -- count one HR tick, true when a packet is due          */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+bool RobotSimViewDue(RobotSimView_t *View)
+{
+    if (View->RateDivisor == 0 || --View->Countdown != 0)
+    {
+        return false;
+    }
+
+    View->Countdown = View->RateDivisor;
+
+    return true;
+
+} /* End of RobotSimViewDue() */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* RobotSimViewPack() -- run the copy plan, returns the bytes written         */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+uint32_t RobotSimViewPack(const RobotSimView_t *View, void *Dst)
+{
+    const RobotSimViewCopy_t *Copy = View->Plan;
+    const RobotSimViewCopy_t *End  = View->Plan + View->NumCopies;
+    uint8_t                  *Out  = Dst;
+
+    for (; Copy < End; Copy++)
+    {
+        memcpy(Out, Copy->Src, Copy->Length);
+        Out += Copy->Length;
+    }
+
+    return View->Size;
+
+} /* End of RobotSimViewPack() */
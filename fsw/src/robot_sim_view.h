@@ -0,0 +1,89 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_view.h
+**
+** Purpose:
+**   Commandable telemetry views: a list of fields compiled into a flat
+**   copy plan.
+**
+** Notes:
+**   The app describes where each field lives as one or more memory
+**   segments. Defining a view resolves its field list against those
+**   segments once, merging ones that are adjacent in memory, so packing is
+**   just the plan's memcpy sequence. Like the model core, this module has
+**   no cFE/OSAL dependency.
+**
+*******************************************************************************/
+
+#ifndef _robot_sim_view_h_
+#define _robot_sim_view_h_
+
+#include "robot_sim_mission_cfg.h"
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/*
+** Most segments behind one field: the HR tick and every rate group
+*/
+#define ROBOT_SIM_VIEW_MAX_SEGMENTS (1 + ROBOT_SIM_MAX_RATE_GROUPS)
+#define ROBOT_SIM_VIEW_MAX_COPIES   (ROBOT_SIM_VIEW_MAX_FIELDS * ROBOT_SIM_VIEW_MAX_SEGMENTS)
+
+/*
+** One contiguous run of source memory
+*/
+typedef struct
+{
+    const void *Src;
+    size_t      Length;
+} RobotSimViewCopy_t;
+
+/*
+** Where a field's data lives, in packing order
+*/
+typedef struct
+{
+    uint32_t           NumSegments; /**< 0 if the field is not available */
+    RobotSimViewCopy_t Segment[ROBOT_SIM_VIEW_MAX_SEGMENTS];
+} RobotSimViewField_t;
+
+typedef struct
+{
+    uint16_t RateDivisor; /**< HR ticks between packets, 0 if the view is not defined */
+    uint16_t Countdown;   /**< HR ticks until the next packet */
+    uint32_t FieldMask;   /**< Bit n set if field n is in the view */
+    uint32_t Size;        /**< Packed bytes */
+    uint32_t NumCopies;
+    RobotSimViewCopy_t Plan[ROBOT_SIM_VIEW_MAX_COPIES];
+} RobotSimView_t;
+
+/****************************************************************************/
+/*
+** Function prototypes.
+*/
+void     RobotSimViewInit(RobotSimView_t *View);
+bool     RobotSimViewCompile(RobotSimView_t *View, const RobotSimViewField_t *Catalog, const uint8_t *Fields,
+                             uint32_t NumFields, uint16_t RateDivisor);
+bool     RobotSimViewDue(RobotSimView_t *View);
+uint32_t RobotSimViewPack(const RobotSimView_t *View, void *Dst);
+
+#endif /* _robot_sim_view_h_ */
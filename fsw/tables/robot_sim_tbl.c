@@ -22,12 +22,70 @@
 
 #include "cfe_tbl_filedef.h" /* Required to obtain the CFE_TBL_FILEDEF macro definition */
 #include "robot_sim_table.h"
+#include "robot_sim_events.h"
 
 /*
-** The following is an example of the declaration statement that defines the desired
-** contents of the table image.
+** Joint gains: softer in the folded regions beyond +/-90 deg, where the
+** arm's own reach no longer stiffens it. Goal rate is fed forward in
+** full; the kinematic plant has no lag worth an acceleration term.
 */
-RobotSimTable_t RobotSimTable = {1, 2};
+#define ROBOT_SIM_TBL_GAINS(MaxRate)                                                                         \
+    {                                                                                                        \
+        {-1.570796f, 1.570796f}, {0.006f, 0.01f, 0.006f}, {1.0e-5f, 1.0e-5f, 1.0e-5f}, {0.02f, 0.02f, 0.02f}, \
+            5.0e-5f, (MaxRate), 0.5f, 1.0f, 0.0f                                                             \
+    }
+
+/*
+** SSRMS-like arm stretched along +x: shoulder roll, yaw and pitch, elbow
+** pitch, wrist pitch, yaw and roll. Joint housings are modelled as 150 kg
+** blocks and the two 7.11 m booms as 300 kg rods. All joints have the
+** SSRMS +/-270 deg travel. Shoulder and elbow joints are rate limited to
+** 0.5 rad/s and 10 kN m, wrist joints to 1 rad/s and 1 kN m.
+**
+** Command confirmations and the errors a bad command stream repeats are
+** budgeted; everything else is rare and always sent.
+*/
+RobotSimTable_t RobotSimTable = {
+    NUM_JOINTS,
+    0,
+    {
+        /* Type, Origin, Axis, MinAngle, MaxAngle, Mass, Com, Inertia, MaxTorque, Gains */
+        {ROBOT_SIM_JOINT_REVOLUTE, {0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, 1.0f}, -4.712389f, 4.712389f, 150.0f,
+         {0.0f, 0.0f, 0.19f}, {7.0f, 7.0f, 7.0f, 0.0f, 0.0f, 0.0f}, 10000.0f,
+         ROBOT_SIM_TBL_GAINS(0.5f)},
+        {ROBOT_SIM_JOINT_REVOLUTE, {0.0f, 0.0f, 0.38f}, {1.0f, 0.0f, 0.0f}, -4.712389f, 4.712389f, 150.0f,
+         {0.19f, 0.0f, 0.0f}, {7.0f, 7.0f, 7.0f, 0.0f, 0.0f, 0.0f}, 10000.0f,
+         ROBOT_SIM_TBL_GAINS(0.5f)},
+        {ROBOT_SIM_JOINT_REVOLUTE, {0.38f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, -4.712389f, 4.712389f, 300.0f,
+         {3.555f, 0.0f, 0.0f}, {10.0f, 1264.0f, 1264.0f, 0.0f, 0.0f, 0.0f}, 10000.0f,
+         ROBOT_SIM_TBL_GAINS(0.5f)},
+        {ROBOT_SIM_JOINT_REVOLUTE, {7.11f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, -4.712389f, 4.712389f, 300.0f,
+         {3.555f, 0.0f, 0.0f}, {10.0f, 1264.0f, 1264.0f, 0.0f, 0.0f, 0.0f}, 10000.0f,
+         ROBOT_SIM_TBL_GAINS(0.5f)},
+        {ROBOT_SIM_JOINT_REVOLUTE, {7.11f, 0.0f, 0.0f}, {0.0f, 1.0f, 0.0f}, -4.712389f, 4.712389f, 150.0f,
+         {0.19f, 0.0f, 0.0f}, {7.0f, 7.0f, 7.0f, 0.0f, 0.0f, 0.0f}, 1000.0f,
+         ROBOT_SIM_TBL_GAINS(1.0f)},
+        {ROBOT_SIM_JOINT_REVOLUTE, {0.38f, 0.0f, 0.0f}, {1.0f, 0.0f, 0.0f}, -4.712389f, 4.712389f, 150.0f,
+         {0.0f, 0.0f, 0.19f}, {7.0f, 7.0f, 7.0f, 0.0f, 0.0f, 0.0f}, 1000.0f,
+         ROBOT_SIM_TBL_GAINS(1.0f)},
+        {ROBOT_SIM_JOINT_REVOLUTE, {0.0f, 0.0f, 0.38f}, {0.0f, 0.0f, 1.0f}, -4.712389f, 4.712389f, 100.0f,
+         {0.0f, 0.0f, 0.25f}, {5.0f, 5.0f, 3.0f, 0.0f, 0.0f, 0.0f}, 1000.0f,
+         ROBOT_SIM_TBL_GAINS(1.0f)},
+    },
+    {0.0f, 0.0f, 0.5f},
+    0.0f,
+    {
+        /* EventID, Flags, Rate (per housekeeping request), Burst */
+        {ROBOT_SIM_COMMANDJNT_INF_EID, ROBOT_SIM_EVENT_CONFIRM, 5, 10},
+        {ROBOT_SIM_COMMANDCTL_INF_EID, ROBOT_SIM_EVENT_CONFIRM, 5, 10},
+        {ROBOT_SIM_SENSOR_INF_EID, ROBOT_SIM_EVENT_CONFIRM, 5, 10},
+        {ROBOT_SIM_REC_INF_EID, ROBOT_SIM_EVENT_CONFIRM, 5, 10},
+        {ROBOT_SIM_COMMAND_ERR_EID, 0, 5, 10},
+        {ROBOT_SIM_INVALID_MSGID_ERR_EID, 0, 2, 5},
+        {ROBOT_SIM_LEN_ERR_EID, 0, 2, 5},
+        {ROBOT_SIM_CTRL_QUEUE_ERR_EID, 0, 2, 5},
+    },
+};
 
 /*
 ** The macro below identifies:
@@ -36,4 +94,4 @@ RobotSimTable_t RobotSimTable = {1, 2};
 **    3) a brief description of the contents of the file image
 **    4) the desired name of the table image binary file that is cFE compatible
 */
-CFE_TBL_FILEDEF(RobotSimTable, RobotSim.RobotSimTable, Table Utility Test Table, robot_sim_tbl.tbl)
+CFE_TBL_FILEDEF(RobotSimTable, RobotSim.RobotSimTable, Arm Model and Gains, robot_sim_tbl.tbl)
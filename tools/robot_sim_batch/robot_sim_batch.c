@@ -0,0 +1,388 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_batch.c
+**
+** Purpose:
+**   Headless Monte Carlo driver for the robot sim model core. Runs many
+**   independent simulations with randomized gains, initial states and goals
+**   across a pool of worker threads and streams one summary line per run.
+**
+** Notes:
+**   Every run is configured from the default arm table the way the app
+**   applies it (PID gains, anti-windup, rate limits) and ticks the same
+**   control, physics and dynamics stages, so the drive acceleration limits
+**   track the arm pose. The randomized gain is a scale on the table Kp.
+**
+**   Each run derives its random stream from (seed, run index) only, so the
+**   set of results is identical regardless of the number of threads (lines
+**   may appear in any order; sort on the run column).
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_dyn.h"
+#include "robot_sim_kin.h"
+#include "robot_sim_model.h"
+#include "robot_sim_platform_cfg.h"
+
+#include <math.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+** Runs claimed by a worker at a time; keeps the shared counter off the hot path
+*/
+#define BATCH_CHUNK_RUNS 16
+
+/*
+** Result lines buffered per worker before taking the output lock
+*/
+#define BATCH_LINE_BUFFER 8192
+
+/*
+** Fraction of the step size that defines the settling band
+*/
+#define BATCH_SETTLE_BAND 0.02f
+
+/*
+** Arm model and gains from the default table image
+*/
+extern RobotSimTable_t RobotSimTable;
+
+typedef struct
+{
+    unsigned long Runs;
+    unsigned long Ticks;
+    unsigned int  Threads;
+    uint64_t      Seed;
+    float         KpMin; /**< Scale on the table Kp */
+    float         KpMax;
+    float         JointRange;
+    const char   *OutputName;
+} BatchConfig_t;
+
+typedef struct
+{
+    unsigned long Run;
+    uint64_t      Seed;
+    float         Kp; /**< Scale on the table Kp */
+    long          SettleTicks; /**< -1 if the run never settled */
+    float         OvershootPct;
+    float         FinalError;
+} BatchResult_t;
+
+typedef struct
+{
+    const BatchConfig_t *Config;
+    unsigned long        NextRun; /**< Shared work counter, accessed atomically */
+    FILE                *Output;
+    pthread_mutex_t      OutputLock;
+} BatchShared_t;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BatchSplitMix64() -- seed expander used for per-run random streams        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint64_t BatchSplitMix64(uint64_t *State)
+{
+    uint64_t z = (*State += 0x9E3779B97F4A7C15ULL);
+
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+static float BatchUniform(uint64_t *State, float Min, float Max)
+{
+    float u = (float)(BatchSplitMix64(State) >> 40) * (1.0f / 16777216.0f);
+
+    return Min + (Max - Min) * u;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BatchRunOne() -- simulate one randomized run and summarize it             */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void BatchRunOne(const BatchConfig_t *Config, unsigned long Run, BatchResult_t *Result)
+{
+    RobotSimModel_t Model;
+    RobotSimKin_t   Kin;
+    RobotSimDyn_t   Dyn;
+    uint64_t        Rng;
+    float           Goal[NUM_JOINTS];
+    float           Start[NUM_JOINTS];
+    float           Band[NUM_JOINTS];
+    float           Rate[NUM_JOINTS];
+    float           Accel[NUM_JOINTS];
+    float           AccelLimit[NUM_JOINTS];
+    float           Overshoot   = 0.0f;
+    float           FinalError  = 0.0f;
+    long            LastOutside = -1;
+    unsigned long   Tick;
+    int             i;
+    int             r;
+
+    Rng = Config->Seed ^ (0xD1B54A32D192ED03ULL * (uint64_t)(Run + 1));
+
+    Result->Run  = Run;
+    Result->Seed = Rng;
+    Result->Kp   = BatchUniform(&Rng, Config->KpMin, Config->KpMax);
+
+    RobotSimModelInit(&Model, 0.0f);
+    RobotSimModelApplyTable(&Model, &RobotSimTable, ROBOT_SIM_PHYSICS_DT);
+    for (r = 0; r < ROBOT_SIM_PID_REGIONS; r++)
+    {
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Model.Pid.Kp[r][i] *= Result->Kp;
+        }
+    }
+    RobotSimKinInit(&Kin, &RobotSimTable);
+    RobotSimDynInit(&Dyn, &RobotSimTable);
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Start[i]          = BatchUniform(&Rng, -Config->JointRange, Config->JointRange);
+        Goal[i]           = BatchUniform(&Rng, -Config->JointRange, Config->JointRange);
+        Model.Position[i] = Start[i];
+        Band[i]           = BATCH_SETTLE_BAND * fabsf(Goal[i] - Start[i]);
+        if (Band[i] < 1.0e-4f)
+        {
+            Band[i] = 1.0e-4f;
+        }
+    }
+    RobotSimModelSetGoal(&Model, Goal);
+
+    for (Tick = 0; Tick < Config->Ticks; Tick++)
+    {
+        RobotSimModelStep(&Model);
+        RobotSimKinSetJoints(&Kin, Model.Position);
+
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Rate[i]  = Model.Applied[i] / ROBOT_SIM_PHYSICS_DT;
+            Accel[i] = Model.AppliedChange[i] / (ROBOT_SIM_PHYSICS_DT * ROBOT_SIM_PHYSICS_DT);
+        }
+        RobotSimDynUpdate(&Dyn, &Kin, Rate, Accel);
+        RobotSimDynAccelLimit(&Dyn, ROBOT_SIM_PHYSICS_DT, AccelLimit);
+        RobotSimModelSetAccelLimit(&Model, AccelLimit);
+
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            float Step = Goal[i] - Start[i];
+            float Past = (Model.Position[i] - Goal[i]) * (Step >= 0.0f ? 1.0f : -1.0f);
+
+            if (Past > 0.0f && fabsf(Step) > 0.0f && Past / fabsf(Step) > Overshoot)
+            {
+                Overshoot = Past / fabsf(Step);
+            }
+            if (fabsf(Goal[i] - Model.Position[i]) > Band[i])
+            {
+                LastOutside = (long)Tick;
+            }
+        }
+    }
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        if (fabsf(Goal[i] - Model.Position[i]) > FinalError)
+        {
+            FinalError = fabsf(Goal[i] - Model.Position[i]);
+        }
+    }
+
+    Result->OvershootPct = 100.0f * Overshoot;
+    Result->FinalError   = FinalError;
+    Result->SettleTicks  = ((unsigned long)(LastOutside + 1) < Config->Ticks) ? LastOutside + 1 : -1;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BatchWorker() -- claim chunks of runs until the batch is exhausted        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void *BatchWorker(void *Arg)
+{
+    BatchShared_t       *Shared = Arg;
+    const BatchConfig_t *Config = Shared->Config;
+    BatchResult_t        Result;
+    char                 Lines[BATCH_LINE_BUFFER];
+    size_t               Used = 0;
+    unsigned long        First;
+    unsigned long        Run;
+
+    while ((First = __atomic_fetch_add(&Shared->NextRun, BATCH_CHUNK_RUNS, __ATOMIC_RELAXED)) < Config->Runs)
+    {
+        for (Run = First; Run < First + BATCH_CHUNK_RUNS && Run < Config->Runs; Run++)
+        {
+            BatchRunOne(Config, Run, &Result);
+
+            if (Used + 128 > sizeof(Lines))
+            {
+                pthread_mutex_lock(&Shared->OutputLock);
+                fwrite(Lines, 1, Used, Shared->Output);
+                pthread_mutex_unlock(&Shared->OutputLock);
+                Used = 0;
+            }
+
+            Used += snprintf(&Lines[Used], sizeof(Lines) - Used, "%lu,%016llx,%.6f,%ld,%.4f,%.6g\n", Result.Run,
+                             (unsigned long long)Result.Seed, Result.Kp, Result.SettleTicks, Result.OvershootPct,
+                             Result.FinalError);
+        }
+    }
+
+    pthread_mutex_lock(&Shared->OutputLock);
+    fwrite(Lines, 1, Used, Shared->Output);
+    pthread_mutex_unlock(&Shared->OutputLock);
+
+    return NULL;
+}
+
+static void BatchUsage(const char *Prog)
+{
+    fprintf(stderr,
+            "usage: %s [-n runs] [-k ticks] [-j threads] [-s seed] [-p kp_scale_min] [-P kp_scale_max] [-r joint_range]"
+            " [-o results.csv]\n",
+            Prog);
+}
+
+int main(int argc, char *argv[])
+{
+    BatchConfig_t   Config;
+    BatchShared_t   Shared;
+    pthread_t      *Workers;
+    struct timespec Start;
+    struct timespec Stop;
+    double          Elapsed;
+    unsigned int    Started;
+    unsigned int    t;
+    int             opt;
+    long            Cpus = sysconf(_SC_NPROCESSORS_ONLN);
+
+    Config.Runs       = 1000;
+    Config.Ticks      = 20000;
+    Config.Threads    = (Cpus > 0) ? (unsigned int)Cpus : 1;
+    Config.Seed       = 1;
+    Config.KpMin      = 0.5f;
+    Config.KpMax      = 1.5f;
+    Config.JointRange = 3.14159265f;
+    Config.OutputName = "robot_sim_batch.csv";
+
+    while ((opt = getopt(argc, argv, "n:k:j:s:p:P:r:o:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                Config.Runs = strtoul(optarg, NULL, 0);
+                break;
+            case 'k':
+                Config.Ticks = strtoul(optarg, NULL, 0);
+                break;
+            case 'j':
+                Config.Threads = (unsigned int)strtoul(optarg, NULL, 0);
+                break;
+            case 's':
+                Config.Seed = strtoull(optarg, NULL, 0);
+                break;
+            case 'p':
+                Config.KpMin = strtof(optarg, NULL);
+                break;
+            case 'P':
+                Config.KpMax = strtof(optarg, NULL);
+                break;
+            case 'r':
+                Config.JointRange = strtof(optarg, NULL);
+                break;
+            case 'o':
+                Config.OutputName = optarg;
+                break;
+            default:
+                BatchUsage(argv[0]);
+                return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+
+    if (Config.Threads == 0 || Config.Ticks == 0)
+    {
+        BatchUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    memset(&Shared, 0, sizeof(Shared));
+    Shared.Config = &Config;
+    Shared.Output = fopen(Config.OutputName, "w");
+    if (Shared.Output == NULL)
+    {
+        perror(Config.OutputName);
+        return EXIT_FAILURE;
+    }
+    pthread_mutex_init(&Shared.OutputLock, NULL);
+    fprintf(Shared.Output, "run,seed,kp_scale,settle_ticks,overshoot_pct,final_error\n");
+
+    Workers = calloc(Config.Threads, sizeof(*Workers));
+    if (Workers == NULL)
+    {
+        fclose(Shared.Output);
+        return EXIT_FAILURE;
+    }
+
+    clock_gettime(CLOCK_MONOTONIC, &Start);
+    for (Started = 0; Started < Config.Threads; Started++)
+    {
+        if (pthread_create(&Workers[Started], NULL, BatchWorker, &Shared) != 0)
+        {
+            fprintf(stderr, "robot_sim_batch: only %u of %u worker threads started\n", Started, Config.Threads);
+            break;
+        }
+    }
+    /*
+    ** The threads that did start share out every run between them; with
+    ** none started, run the batch on this thread instead
+    */
+    if (Started == 0)
+    {
+        BatchWorker(&Shared);
+    }
+    for (t = 0; t < Started; t++)
+    {
+        pthread_join(Workers[t], NULL);
+    }
+    clock_gettime(CLOCK_MONOTONIC, &Stop);
+
+    Elapsed = (double)(Stop.tv_sec - Start.tv_sec) + 1.0e-9 * (double)(Stop.tv_nsec - Start.tv_nsec);
+    printf("robot_sim_batch: %lu runs x %lu ticks on %u threads in %.3f s (%.1f runs/s)\n", Config.Runs, Config.Ticks,
+           (Started > 0) ? Started : 1, Elapsed, (Elapsed > 0.0) ? (double)Config.Runs / Elapsed : 0.0);
+
+    free(Workers);
+    pthread_mutex_destroy(&Shared.OutputLock);
+    fclose(Shared.Output);
+
+    return EXIT_SUCCESS;
+}
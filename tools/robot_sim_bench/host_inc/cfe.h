@@ -0,0 +1,199 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: cfe.h
+**
+** Purpose:
+**   Host stand-in for the cFE API: the subset of ES, EVS, SB, MSG, TBL,
+**   TIME, FS and PSP the robot sim app uses, so robot_sim.c and its
+**   scheduler and recorder compile into the host tools unchanged. The
+**   message layout is CCSDS: a 6 byte primary header, 8 byte command and
+**   16 byte telemetry headers. Implemented in robot_sim_bench_cfe.c.
+**
+*******************************************************************************/
+#ifndef _cfe_h_
+#define _cfe_h_
+
+#include "osapi.h"
+#include "cfe_error.h"
+
+#define CFE_MISSION_MAX_API_LEN            20
+#define CFE_MISSION_EVS_MAX_MESSAGE_LENGTH 122
+
+/*
+** PSP
+*/
+void CFE_PSP_GetTime(OS_time_t *LocalTime);
+
+/*
+** ES
+*/
+enum
+{
+    CFE_ES_RunStatus_UNDEFINED = 0,
+    CFE_ES_RunStatus_APP_RUN   = 1,
+    CFE_ES_RunStatus_APP_EXIT  = 2,
+    CFE_ES_RunStatus_APP_ERROR = 3
+};
+
+#define CFE_ES_PerfLogEntry(id) (CFE_ES_PerfLogAdd(id, 0))
+#define CFE_ES_PerfLogExit(id)  (CFE_ES_PerfLogAdd(id, 1))
+
+void  CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit);
+bool  CFE_ES_RunLoop(uint32 *RunStatus);
+void  CFE_ES_ExitApp(uint32 ExitStatus);
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...) OS_PRINTF(1, 2);
+
+/*
+** EVS
+*/
+typedef struct
+{
+    uint16 EventID;
+    uint16 Mask;
+} CFE_EVS_BinFilter_t;
+
+enum
+{
+    CFE_EVS_EventFilter_BINARY = 0
+};
+
+enum
+{
+    CFE_EVS_EventType_DEBUG       = 1,
+    CFE_EVS_EventType_INFORMATION = 2,
+    CFE_EVS_EventType_ERROR       = 3,
+    CFE_EVS_EventType_CRITICAL    = 4
+};
+
+#define CFE_EVS_NO_FILTER      0x0000
+#define CFE_EVS_FIRST_ONE_STOP 0xFFFF
+
+int32 CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme);
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...) OS_PRINTF(3, 4);
+
+/*
+** MSG and SB
+*/
+typedef union
+{
+    uint8 Byte[6]; /**< CCSDS primary header: stream ID, sequence, length */
+} CFE_MSG_Message_t;
+
+typedef struct
+{
+    CFE_MSG_Message_t Msg;
+    uint8             FunctionCode;
+    uint8             Checksum;
+} CFE_MSG_CommandHeader_t;
+
+typedef struct
+{
+    CFE_MSG_Message_t Msg;
+    uint8             Time[6];
+    uint8             Spare[4];
+} CFE_MSG_TelemetryHeader_t;
+
+typedef union
+{
+    CFE_MSG_Message_t Msg;
+    long long int     LongInt;
+    long double       LongDouble;
+} CFE_SB_Buffer_t;
+
+typedef uint32 CFE_SB_MsgId_t;
+typedef uint32 CFE_SB_MsgId_Atom_t;
+typedef uint32 CFE_SB_PipeId_t;
+typedef uint16 CFE_MSG_FcnCode_t;
+typedef size_t CFE_MSG_Size_t;
+
+#define CFE_SB_INVALID_MSG_ID    ((CFE_SB_MsgId_t)0)
+#define CFE_SB_PEND_FOREVER      (-1)
+#define CFE_SB_ValueToMsgId(x)   ((CFE_SB_MsgId_t)(x))
+#define CFE_SB_MsgIdToValue(x)   ((CFE_SB_MsgId_Atom_t)(x))
+#define CFE_SB_MsgId_Equal(a, b) ((a) == (b))
+#define CFE_SB_IsValidMsgId(x)   ((x) != CFE_SB_INVALID_MSG_ID && (x) <= 0xFFFF)
+
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size);
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId);
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size);
+int32 CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode);
+int32 CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode);
+
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName);
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
+void  CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr);
+int32 CFE_SB_TransmitMsg(CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount);
+
+/*
+** TBL
+*/
+typedef int16 CFE_TBL_Handle_t;
+typedef int32 (*CFE_TBL_CallbackFuncPtr_t)(void *TblPtr);
+
+#define CFE_TBL_OPT_DEFAULT 0x0000
+
+typedef enum
+{
+    CFE_TBL_SRC_FILE    = 0,
+    CFE_TBL_SRC_ADDRESS = 1
+} CFE_TBL_SrcEnum_t;
+
+int32 CFE_TBL_Register(CFE_TBL_Handle_t *TblHandlePtr, const char *Name, size_t Size, uint16 TblOptionFlags,
+                       CFE_TBL_CallbackFuncPtr_t TblValidationFuncPtr);
+int32 CFE_TBL_Load(CFE_TBL_Handle_t TblHandle, CFE_TBL_SrcEnum_t SrcType, const void *SrcDataPtr);
+int32 CFE_TBL_GetAddress(void **TblPtr, CFE_TBL_Handle_t TblHandle);
+int32 CFE_TBL_ReleaseAddress(CFE_TBL_Handle_t TblHandle);
+int32 CFE_TBL_Manage(CFE_TBL_Handle_t TblHandle);
+
+/*
+** TIME
+*/
+typedef struct
+{
+    uint32 Seconds;
+    uint32 Subseconds;
+} CFE_TIME_SysTime_t;
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void);
+
+/*
+** FS
+*/
+#define CFE_FS_HDR_DESC_MAX_LEN 32
+
+typedef struct
+{
+    uint32 ContentType;
+    uint32 SubType;
+    uint32 Length;
+    uint32 SpacecraftID;
+    uint32 ProcessorID;
+    uint32 ApplicationID;
+    uint32 TimeSeconds;
+    uint32 TimeSubSeconds;
+    char   Description[CFE_FS_HDR_DESC_MAX_LEN];
+} CFE_FS_Header_t;
+
+void  CFE_FS_InitHeader(CFE_FS_Header_t *Hdr, const char *Description, uint32 SubType);
+int32 CFE_FS_WriteHeader(osal_id_t FileDes, CFE_FS_Header_t *Hdr);
+
+#endif /* _cfe_h_ */
@@ -0,0 +1,38 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: cfe_error.h
+**
+** Purpose:
+**   Host stand-in for the cFE status codes the robot sim app uses.
+**
+*******************************************************************************/
+#ifndef _cfe_error_h_
+#define _cfe_error_h_
+
+#define CFE_SUCCESS                       ((int32)0)
+#define CFE_STATUS_VALIDATION_FAILURE     ((int32)0xc8000003)
+#define CFE_STATUS_EXTERNAL_RESOURCE_FAIL ((int32)0xc8000006)
+#define CFE_STATUS_NOT_IMPLEMENTED        ((int32)0xc800ffff)
+#define CFE_TBL_INFO_UPDATED              ((int32)0x4c000007)
+#define CFE_TBL_ERR_INVALID_HANDLE        ((int32)0xcc000001)
+#define CFE_SB_NO_MESSAGE                 ((int32)0xca00000e)
+
+#endif /* _cfe_error_h_ */
@@ -0,0 +1,83 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: osapi.h
+**
+** Purpose:
+**   Host stand-in for the OSAL API: the common types and the subset of
+**   file and time calls the robot sim app uses. Implemented on POSIX in
+**   robot_sim_bench_cfe.c.
+**
+*******************************************************************************/
+#ifndef _osapi_h_
+#define _osapi_h_
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef int8_t    int8;
+typedef int16_t   int16;
+typedef int32_t   int32;
+typedef int64_t   int64;
+typedef uint8_t   uint8;
+typedef uint16_t  uint16;
+typedef uint32_t  uint32;
+typedef uint64_t  uint64;
+typedef uintptr_t cpuaddr;
+
+#define CompileTimeAssert(Condition, Message) typedef char Message[(Condition) ? 1 : -1]
+
+#define OS_PRINTF(n, m) __attribute__((format(printf, n, m)))
+
+#define OS_SUCCESS      0
+#define OS_ERROR        (-1)
+#define OS_MAX_PATH_LEN 64
+
+typedef uint32 osal_id_t;
+
+/*
+** Ticks of 100 ns, as in OSAL
+*/
+typedef struct
+{
+    int64 ticks;
+} OS_time_t;
+
+typedef enum
+{
+    OS_FILE_FLAG_NONE     = 0x00,
+    OS_FILE_FLAG_CREATE   = 0x01,
+    OS_FILE_FLAG_TRUNCATE = 0x02
+} OS_file_flag_t;
+
+#define OS_READ_ONLY  0
+#define OS_WRITE_ONLY 1
+#define OS_READ_WRITE 2
+
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode);
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes);
+int32 OS_close(osal_id_t filedes);
+void  OS_printf(const char *string, ...) OS_PRINTF(1, 2);
+
+OS_time_t OS_TimeSubtract(OS_time_t time1, OS_time_t time2);
+int64     OS_TimeGetTotalMicroseconds(OS_time_t tm);
+
+#endif /* _osapi_h_ */
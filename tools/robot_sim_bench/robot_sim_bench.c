@@ -0,0 +1,1129 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_bench.c
+**
+** Purpose:
+**   Host-side micro-benchmarks of the robot sim modules, and of the app's
+**   command dispatch, event path and high rate loop run against the host
+**   cFE stand-in in robot_sim_bench_cfe.c. Prints one line per benchmark with the mean cost per operation and,
+**   where the kernel exposes hardware counters, L1 data cache read misses
+**   per operation.
+**
+**   Run as "robot_sim_bench -b robot_sim_bench_baseline.json" it is a
+**   regression check: the exit status is non-zero if any benchmark fails
+**   or is slower than the checked-in baseline by more than the threshold,
+**   or any module state grew. "-o" writes a new baseline after an accepted
+**   change. Baselines are host specific; regenerate them on the machine
+**   that runs the check.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_events.h"
+#include "robot_sim_version.h"
+#include "robot_sim.h"
+
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/ioctl.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <time.h>
+#include <unistd.h>
+
+#define BENCH_DEFAULT_ITERATIONS 10000000UL
+#define BENCH_DEFAULT_THRESHOLD  50.0 /* Percent slower than the baseline */
+
+/*
+** Returned by a benchmark whose operation failed; it has no cost
+*/
+#define BENCH_FAILED (-1.0)
+
+/*
+** Cold-cache runs evict between operations, so run fewer of them
+*/
+#define BENCH_COLD_DIVISOR 100UL
+#define BENCH_EVICT_BYTES  (256UL * 1024UL)
+
+/*
+** Default kinematic model, compiled from fsw/tables/robot_sim_tbl.c
+*/
+extern RobotSimTable_t RobotSimTable;
+
+/*
+** The app's state, defined in robot_sim.c
+*/
+extern RobotSimData_t RobotSimData;
+
+typedef double (*BenchFunc_t)(unsigned long Iterations);
+
+typedef struct
+{
+    const char   *Name;
+    BenchFunc_t   Func;
+    unsigned long Divisor; /**< Runs Iterations / Divisor operations */
+} BenchEntry_t;
+
+static double BenchNow(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return 1.0e9 * (double)ts.tv_sec + (double)ts.tv_nsec;
+}
+
+/*
+** Keeps the compiler from discarding benchmarked work
+*/
+static volatile uint32_t BenchSink;
+
+static RobotSimCmdQueue_t BenchQueue;
+
+/*
+** L1 data cache read miss counter, -1 if the kernel does not offer one
+*/
+static int BenchMissFd = -1;
+
+static void BenchMissOpen(void)
+{
+    struct perf_event_attr Attr;
+
+    memset(&Attr, 0, sizeof(Attr));
+    Attr.type           = PERF_TYPE_HW_CACHE;
+    Attr.size           = sizeof(Attr);
+    Attr.config         = PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                          (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+    Attr.disabled       = 1;
+    Attr.exclude_kernel = 1;
+    Attr.exclude_hv     = 1;
+
+    BenchMissFd = (int)syscall(SYS_perf_event_open, &Attr, 0, -1, -1, 0);
+}
+
+static void BenchMissEnable(bool Enable)
+{
+    if (BenchMissFd >= 0)
+    {
+        ioctl(BenchMissFd, Enable ? PERF_EVENT_IOC_ENABLE : PERF_EVENT_IOC_DISABLE, 0);
+    }
+}
+
+static uint64_t BenchMissRead(void)
+{
+    uint64_t Count = 0;
+
+    if (BenchMissFd >= 0 && read(BenchMissFd, &Count, sizeof(Count)) != sizeof(Count))
+    {
+        Count = 0;
+    }
+
+    return Count;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchCmdQueuePushPop() -- uncontended push followed by pop                 */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchCmdQueuePushPop(unsigned long Iterations)
+{
+    RobotSimCtrlReq_t In;
+    RobotSimCtrlReq_t Out;
+    unsigned long     i;
+    double            Start;
+
+    memset(&In, 0, sizeof(In));
+    In.Type = ROBOT_SIM_REQ_SETPOINT;
+    RobotSimCmdQueueInit(&BenchQueue);
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        In.Data.Goal[0] = (float)i;
+        RobotSimCmdQueuePush(&BenchQueue, &In);
+        RobotSimCmdQueuePop(&BenchQueue, &Out);
+        BenchSink += Out.Type;
+    }
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+static void *BenchCmdQueueProducer(void *Arg)
+{
+    unsigned long     Iterations = *(unsigned long *)Arg;
+    RobotSimCtrlReq_t In;
+    unsigned long     i;
+
+    memset(&In, 0, sizeof(In));
+    In.Type = ROBOT_SIM_REQ_SETPOINT;
+
+    for (i = 0; i < Iterations; i++)
+    {
+        In.Data.Goal[0] = (float)i;
+        while (!RobotSimCmdQueuePush(&BenchQueue, &In))
+        {
+            sched_yield();
+        }
+    }
+
+    return NULL;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchCmdQueueTransfer() -- producer and consumer on separate threads       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchCmdQueueTransfer(unsigned long Iterations)
+{
+    pthread_t         Producer;
+    RobotSimCtrlReq_t Out;
+    unsigned long     Received = 0;
+    double            Start;
+
+    RobotSimCmdQueueInit(&BenchQueue);
+
+    Start = BenchNow();
+    pthread_create(&Producer, NULL, BenchCmdQueueProducer, &Iterations);
+    while (Received < Iterations)
+    {
+        if (RobotSimCmdQueuePop(&BenchQueue, &Out))
+        {
+            BenchSink += Out.Type;
+            Received++;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    pthread_join(Producer, NULL);
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchSensorSample() -- one encoder sample of all joints, every effect on   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchSensorSample(unsigned long Iterations)
+{
+    static RobotSimSensor_t Sensor;
+    float                   Truth[NUM_JOINTS];
+    float                   Measured[NUM_JOINTS];
+    unsigned long           i;
+    int                     j;
+    double                  Start;
+
+    RobotSimSensorInit(&Sensor, 1);
+    for (j = 0; j < NUM_JOINTS; j++)
+    {
+        Truth[j]                         = 0.1f * (float)j;
+        Sensor.Config.NoiseStdDev[j]     = 1.0e-3f;
+        Sensor.Config.BiasDriftStdDev[j] = 1.0e-6f;
+        Sensor.Config.Quantum[j]         = 1.0e-4f;
+        Sensor.Config.DropoutProb[j]     = 0.01f;
+        Sensor.Config.DelaySamples[j]    = (uint32_t)j;
+    }
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        RobotSimSensorSample(&Sensor, Truth, Measured);
+        BenchSink += (uint32_t)Measured[0];
+    }
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchKinToolFrame() -- tool frame query after one joint moves              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchKinToolFrame(unsigned long Iterations)
+{
+    static RobotSimKin_t   Kin;
+    const RobotSimXform_t *Tool;
+    float                  Angle[NUM_JOINTS];
+    unsigned long          i;
+    double                 Start;
+
+    memset(Angle, 0, sizeof(Angle));
+    RobotSimKinInit(&Kin, &RobotSimTable);
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        Angle[i % NUM_JOINTS] += 1.0e-6f;
+        RobotSimKinSetJoints(&Kin, Angle);
+        Tool = RobotSimKinGetFrame(&Kin, ROBOT_SIM_KIN_TOOL);
+        BenchSink += (uint32_t)Tool->p[0];
+    }
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchKinModelBind() -- startup cost of a loaded model up to the first pose */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchKinModelBind(unsigned long Iterations)
+{
+    static RobotSimKin_t   Kin;
+    const RobotSimXform_t *Tool;
+    unsigned long          i;
+    double                 Start;
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        if (RobotSimKinValidate(&RobotSimTable))
+        {
+            RobotSimKinInit(&Kin, &RobotSimTable);
+            Tool = RobotSimKinGetFrame(&Kin, ROBOT_SIM_KIN_TOOL);
+            BenchSink += (uint32_t)Tool->p[0];
+        }
+    }
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchVelSolve() -- velocity mode control tick: Jacobian, monitor, solve    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchVelSolve(unsigned long Iterations)
+{
+    static const RobotSimVelConfig_t Config  = {5.0f, 1.0e-4f, 50.0f, 400.0f};
+    static const float               Twist[6] = {0.1f, 0.0f, 0.05f, 0.0f, 0.0f, 0.01f};
+    static RobotSimKin_t             Kin;
+    static RobotSimVel_t             Vel;
+    float                            Angle[NUM_JOINTS] = {0.3f, -0.5f, 0.7f, 1.1f, -0.4f, 0.2f, 0.9f};
+    unsigned long                    i;
+    double                           Start;
+
+    RobotSimKinInit(&Kin, &RobotSimTable);
+    RobotSimVelInit(&Vel, &Config);
+    RobotSimVelSetTwist(&Vel, Twist);
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        Angle[i % NUM_JOINTS] += 1.0e-6f;
+        RobotSimKinSetJoints(&Kin, Angle);
+        RobotSimVelSolve(&Vel, &Kin);
+        BenchSink += (uint32_t)(Vel.Rate[0] * 1.0e6f);
+    }
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchDynUpdate() -- physics tick dynamics, optionally holding a payload    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchDynUpdateCommon(unsigned long Iterations, const RobotSimPayload_t *Payload)
+{
+    static RobotSimKin_t Kin;
+    static RobotSimDyn_t Dyn;
+    float                Angle[NUM_JOINTS] = {0.3f, -0.5f, 0.7f, 1.1f, -0.4f, 0.2f, 0.9f};
+    float                Rate[NUM_JOINTS]  = {0.01f, -0.02f, 0.03f, 0.01f, -0.05f, 0.02f, 0.04f};
+    float                Accel[NUM_JOINTS] = {0.1f, 0.05f, -0.1f, 0.2f, 0.0f, -0.3f, 0.1f};
+    unsigned long        i;
+    double               Start;
+
+    RobotSimKinInit(&Kin, &RobotSimTable);
+    RobotSimDynInit(&Dyn, &RobotSimTable);
+    if (Payload != NULL)
+    {
+        RobotSimDynGrapple(&Dyn, Payload);
+    }
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        Angle[i % NUM_JOINTS] += 1.0e-6f;
+        RobotSimKinSetJoints(&Kin, Angle);
+        RobotSimDynUpdate(&Dyn, &Kin, Rate, Accel);
+        BenchSink += (uint32_t)Dyn.Torque[0];
+    }
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+static double BenchDynUpdate(unsigned long Iterations)
+{
+    return BenchDynUpdateCommon(Iterations, NULL);
+}
+
+static double BenchDynUpdatePayload(unsigned long Iterations)
+{
+    static const RobotSimPayload_t Payload = {
+        5000.0f, {0.0f, 0.0f, 1.0f}, {2000.0f, 2000.0f, 1000.0f, 0.0f, 0.0f, 0.0f}};
+
+    return BenchDynUpdateCommon(Iterations, &Payload);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchViewPack() -- pack a position, goal, error and pose view              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchViewPack(unsigned long Iterations)
+{
+    static const uint8_t       List[] = {ROBOT_SIM_VIEW_FIELD_POSITION, ROBOT_SIM_VIEW_FIELD_GOALS,
+                                   ROBOT_SIM_VIEW_FIELD_ERRORS, ROBOT_SIM_VIEW_FIELD_POSE};
+    static RobotSimModel_t     Model;
+    static RobotSimKin_t       Kin;
+    static RobotSimViewField_t Catalog[ROBOT_SIM_VIEW_FIELD_COUNT];
+    static RobotSimView_t      View;
+    static uint8_t             Pkt[ROBOT_SIM_VIEW_MAX_BYTES];
+    unsigned long              i;
+    double                     Start;
+
+    RobotSimModelInit(&Model, 0.01f);
+    RobotSimKinInit(&Kin, &RobotSimTable);
+
+    Catalog[ROBOT_SIM_VIEW_FIELD_POSITION].NumSegments = 1;
+    Catalog[ROBOT_SIM_VIEW_FIELD_POSITION].Segment[0]  = (RobotSimViewCopy_t) {Model.Position, sizeof(Model.Position)};
+    Catalog[ROBOT_SIM_VIEW_FIELD_GOALS].NumSegments    = 1;
+    Catalog[ROBOT_SIM_VIEW_FIELD_GOALS].Segment[0]     = (RobotSimViewCopy_t) {Model.Goal, sizeof(Model.Goal)};
+    Catalog[ROBOT_SIM_VIEW_FIELD_ERRORS].NumSegments   = 1;
+    Catalog[ROBOT_SIM_VIEW_FIELD_ERRORS].Segment[0]    = (RobotSimViewCopy_t) {Model.Error, sizeof(Model.Error)};
+    Catalog[ROBOT_SIM_VIEW_FIELD_POSE].NumSegments     = 1;
+    Catalog[ROBOT_SIM_VIEW_FIELD_POSE].Segment[0] =
+        (RobotSimViewCopy_t) {&Kin.Frame[ROBOT_SIM_KIN_TOOL], sizeof(Kin.Frame[ROBOT_SIM_KIN_TOOL])};
+
+    RobotSimViewCompile(&View, Catalog, List, sizeof(List), 1);
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        Model.Position[i % NUM_JOINTS] += 1.0e-6f;
+        if (RobotSimViewDue(&View))
+        {
+            BenchSink += RobotSimViewPack(&View, Pkt) + Pkt[i % 16];
+        }
+    }
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchCosimStep() -- lockstep round trip to a physics peer thread           */
+/*                                                                            */
+/* 1e9 over the result is the step rate the link sustains with a peer that   */
+/* does no work of its own. A step that fails fails the benchmark.           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static void BenchCosimPeerHandler(void *Arg, const RobotSimCosimMsg_t *Request, RobotSimCosimMsg_t *Reply)
+{
+    RobotSimModel_t *Model = Arg;
+    int              i;
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Model->Command[i]    = Request->Rate[i] * Request->Dt;
+        Model->AccelLimit[i] = Request->AccelLimit[i] * Request->Dt * Request->Dt;
+    }
+    RobotSimModelPhysics(Model);
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Reply->Position[i] = Model->Position[i];
+        Reply->Rate[i]     = Model->Applied[i] / Request->Dt;
+    }
+}
+
+static void *BenchCosimPeer(void *Arg)
+{
+    static RobotSimModel_t Model;
+
+    RobotSimModelInit(&Model, 0.0f);
+    RobotSimCosimServe(*(int *)Arg, BenchCosimPeerHandler, &Model);
+
+    return NULL;
+}
+
+static double BenchCosimStep(unsigned long Iterations)
+{
+    static RobotSimModel_t Model;
+    static RobotSimCosim_t Cosim;
+    static float           Torque[NUM_JOINTS];
+    pthread_t              Peer;
+    int                    Fd[2];
+    unsigned long          i = 0;
+    double                 Start;
+    double                 Result = BENCH_FAILED;
+
+    if (socketpair(AF_UNIX, SOCK_SEQPACKET, 0, Fd) != 0)
+    {
+        return BENCH_FAILED;
+    }
+
+    RobotSimModelInit(&Model, 0.01f);
+    Model.Goal[0] = 1.0f;
+    RobotSimCosimInit(&Cosim);
+    RobotSimCosimAttach(&Cosim, Fd[0], 1.0e-3f, 1000);
+    pthread_create(&Peer, NULL, BenchCosimPeer, &Fd[1]);
+
+    if (RobotSimCosimSync(&Cosim, &Model) == ROBOT_SIM_COSIM_OK)
+    {
+        Start = BenchNow();
+        for (i = 0; i < Iterations; i++)
+        {
+            RobotSimModelControl(&Model);
+            if (RobotSimCosimStep(&Cosim, &Model, Torque) != ROBOT_SIM_COSIM_OK)
+            {
+                break;
+            }
+            BenchSink += (uint32_t)(Model.Position[0] * 1.0e6f);
+        }
+        if (i == Iterations)
+        {
+            Result = (BenchNow() - Start) / (double)Iterations;
+        }
+        else
+        {
+            fprintf(stderr, "cosim_step: step %lu of %lu failed\n", i + 1, Iterations);
+        }
+    }
+
+    RobotSimCosimClose(&Cosim);
+    pthread_join(Peer, NULL);
+    close(Fd[1]);
+
+    return Result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchPidControl() -- scheduled PID kernel across all joints                */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchPidControl(unsigned long Iterations)
+{
+    static RobotSimModel_t Model;
+    float                  Goal[NUM_JOINTS] = {1.0f, -2.0f, 0.5f, 2.5f, -0.2f, 0.1f, -1.8f};
+    unsigned long          i;
+    int                    j;
+    int                    r;
+    double                 Start;
+
+    RobotSimModelInit(&Model, 0.01f);
+    for (j = 0; j < NUM_JOINTS; j++)
+    {
+        for (r = 0; r < ROBOT_SIM_PID_REGIONS; r++)
+        {
+            Model.Pid.Ki[r][j] = 1.0e-5f;
+            Model.Pid.Kd[r][j] = 0.02f;
+        }
+        Model.Pid.Breakpoint[0][j]   = -1.5f;
+        Model.Pid.Breakpoint[1][j]   = 1.5f;
+        Model.Pid.IntegratorLimit[j] = 5.0e-5f;
+        Model.Pid.CommandLimit[j]    = 5.0e-4f;
+        Model.Pid.BackCalcGain[j]    = 0.5f;
+    }
+    RobotSimModelSetGoal(&Model, Goal);
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        Model.Position[i % NUM_JOINTS] += 1.0e-6f;
+        RobotSimModelControl(&Model);
+        BenchSink += (uint32_t)(Model.Command[0] * 1.0e6f);
+    }
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchHrTick() -- one internal-physics HR wakeup of the app                 */
+/*                                                                            */
+/* HighRateControLoop() itself: the control request drain and every stage    */
+/* the scheduler runs on the tick, on the app's own state. The cold run     */
+/* writes a buffer larger than L1 and L2 between ticks and only times and    */
+/* counts the tick itself.                                                   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static uint8_t BenchEvict[BENCH_EVICT_BYTES];
+
+static void BenchHrTickInit(void)
+{
+    float Goal[NUM_JOINTS] = {1.0f, -2.0f, 0.5f, 2.5f, -0.2f, 0.1f, -1.8f};
+
+    RobotSimModelSetGoal(&RobotSimData.Model, Goal);
+}
+
+static double BenchHrTick(unsigned long Iterations)
+{
+    unsigned long i;
+    double        Start;
+
+    BenchHrTickInit();
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        HighRateControLoop();
+    }
+    BenchSink += (uint32_t)(RobotSimData.Model.Position[0] * 1.0e6f);
+
+    return (BenchNow() - Start) / (double)Iterations;
+}
+
+static double BenchHrTickCold(unsigned long Iterations)
+{
+    unsigned long i;
+    double        Start;
+    double        Elapsed = 0.0;
+
+    BenchHrTickInit();
+
+    for (i = 0; i < Iterations; i++)
+    {
+        BenchMissEnable(false);
+        memset(BenchEvict, (int)i, sizeof(BenchEvict));
+        BenchMissEnable(true);
+
+        Start = BenchNow();
+        HighRateControLoop();
+        Elapsed += BenchNow() - Start;
+    }
+    BenchSink += (uint32_t)(RobotSimData.Model.Position[0] * 1.0e6f);
+
+    return Elapsed / (double)Iterations;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchCmdDispatch() -- a joint command through the ground command table     */
+/*                                                                            */
+/* RobotSimProcessGroundCommand() with its length check, timing and the     */
+/* handler's post to the control queue, plus the share of the drain at the   */
+/* next wakeup; a pipe's depth of commands is drained at a time. Fails if   */
+/* the app rejects any of them.                                              */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchCmdDispatch(unsigned long Iterations)
+{
+    static union
+    {
+        CFE_SB_Buffer_t         SBBuf;
+        RobotSimJointStateCmd_t Cmd;
+    } Buf;
+    RobotSimCmdStatsTlm_t *Stats = &RobotSimData.CmdStats[ROBOT_SIM_SET_JOINTS_CC];
+    uint32                 Accepted;
+    unsigned long          i;
+    double                 Start;
+    double                 Result;
+
+    CFE_MSG_Init(&Buf.Cmd.CmdHeader.Msg, CFE_SB_ValueToMsgId(ROBOT_SIM_CMD_MID), sizeof(Buf.Cmd));
+    CFE_MSG_SetFcnCode(&Buf.Cmd.CmdHeader.Msg, ROBOT_SIM_SET_JOINTS_CC);
+    Buf.Cmd.joint1 = -2.0f;
+    Buf.Cmd.joint3 = 2.5f;
+
+    Accepted = Stats->AcceptCount;
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        Buf.Cmd.joint0 = (float)(i % 100) * 0.01f;
+        RobotSimProcessGroundCommand(&Buf.SBBuf);
+        if ((i + 1) % ROBOT_SIM_PIPE_DEPTH == 0)
+        {
+            RobotSimDrainCtrlRequests();
+        }
+    }
+    Result = (BenchNow() - Start) / (double)Iterations;
+
+    RobotSimDrainCtrlRequests();
+
+    if (Stats->AcceptCount - Accepted != (uint32)Iterations)
+    {
+        fprintf(stderr, "cmd_dispatch: %lu of %lu commands accepted\n", (unsigned long)(Stats->AcceptCount - Accepted),
+                Iterations);
+        return BENCH_FAILED;
+    }
+
+    return Result;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* BenchEvent() -- event path of a joint command confirmation                 */
+/*                                                                            */
+/* RobotSimSendEvent() as the joint command handler calls it; EVS itself    */
+/* comes on top on the target. event_format has the ID unbudgeted, so it    */
+/* is the formatting every event paid before budgets. event_sent adds the   */
+/* budget check to it, event_suppressed is all an event over budget now     */
+/* costs. The table's budgets are put back afterwards.                       */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static double BenchEventCommon(unsigned long Iterations, bool Budgeted, uint16_t Burst)
+{
+    RobotSimEventBudget_t Budget[ROBOT_SIM_EVENT_BUDGETS];
+    RobotSimEvLim_t      *Lim = &RobotSimData.EvLim;
+    unsigned long         i;
+    double                Start;
+    double                Result;
+
+    memset(Budget, 0, sizeof(Budget));
+    if (Budgeted)
+    {
+        Budget[0] = (RobotSimEventBudget_t) {ROBOT_SIM_COMMANDJNT_INF_EID, ROBOT_SIM_EVENT_CONFIRM, Burst, Burst};
+    }
+    RobotSimEvLimConfigure(Lim, Budget);
+
+    Start = BenchNow();
+    for (i = 0; i < Iterations; i++)
+    {
+        BenchSink += (uint32_t)RobotSimSendEvent(ROBOT_SIM_COMMANDJNT_INF_EID, CFE_EVS_EventType_INFORMATION,
+                                                 "robot sim: joint state command %s", ROBOT_SIM_VERSION);
+        if (Budgeted && Lim->Bucket[0].Tokens == 0)
+        {
+            RobotSimEvLimRefill(Lim);
+        }
+    }
+    Result = (BenchNow() - Start) / (double)Iterations;
+
+    RobotSimEvLimConfigure(Lim, RobotSimData.TblPtr->Events);
+
+    return Result;
+}
+
+static double BenchEventFormat(unsigned long Iterations)
+{
+    return BenchEventCommon(Iterations, false, 0);
+}
+
+static double BenchEventSent(unsigned long Iterations)
+{
+    return BenchEventCommon(Iterations, true, UINT16_MAX);
+}
+
+static double BenchEventSuppressed(unsigned long Iterations)
+{
+    return BenchEventCommon(Iterations, true, 0);
+}
+
+static const BenchEntry_t BenchTable[] = {
+    {"cmdq_push_pop", BenchCmdQueuePushPop, 1},
+    {"cmdq_transfer", BenchCmdQueueTransfer, 1},
+    {"pid_control", BenchPidControl, 1},
+    {"sensor_sample", BenchSensorSample, 1},
+    {"kin_tool_frame", BenchKinToolFrame, 1},
+    {"kin_model_bind", BenchKinModelBind, 1},
+    {"vel_solve", BenchVelSolve, 1},
+    {"dyn_update", BenchDynUpdate, 1},
+    {"dyn_update_payload", BenchDynUpdatePayload, 1},
+    {"view_pack", BenchViewPack, 1},
+    {"cosim_step", BenchCosimStep, 1},
+    {"hr_tick", BenchHrTick, 1},
+    {"hr_tick_cold", BenchHrTickCold, BENCH_COLD_DIVISOR},
+    {"cmd_dispatch", BenchCmdDispatch, 1},
+    {"event_format", BenchEventFormat, 1},
+    {"event_sent", BenchEventSent, 1},
+    {"event_suppressed", BenchEventSuppressed, 1},
+};
+
+/*
+** Static state of each module, the app's hot block and all of its state.
+** The flight modules never allocate, so growth of these is what a memory
+** regression looks like.
+*/
+typedef struct
+{
+    const char *Name;
+    size_t      Bytes;
+} BenchSize_t;
+
+static const BenchSize_t BenchSizeTable[] = {
+    {"model", sizeof(RobotSimModel_t)},   {"kin", sizeof(RobotSimKin_t)},
+    {"dyn", sizeof(RobotSimDyn_t)},       {"sensor", sizeof(RobotSimSensor_t)},
+    {"vel", sizeof(RobotSimVel_t)},       {"cmdq", sizeof(RobotSimCmdQueue_t)},
+    {"view", sizeof(RobotSimView_t)},     {"cosim", sizeof(RobotSimCosim_t)},
+    {"evlim", sizeof(RobotSimEvLim_t)},   {"hr_tick_hot", offsetof(RobotSimData_t, HkTlm)},
+    {"app", sizeof(RobotSimData_t)},
+};
+
+#define BENCH_NUM_BENCHES (sizeof(BenchTable) / sizeof(BenchTable[0]))
+#define BENCH_NUM_SIZES   (sizeof(BenchSizeTable) / sizeof(BenchSizeTable[0]))
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Baseline files                                                             */
+/*                                                                            */
+/* Written by -o and read back by -b, one value per line:                    */
+/*                                                                            */
+/*   {                                                                        */
+/*       "iterations": 300000,                                                */
+/*       "repeats": 3,                                                        */
+/*       "ns_per_op": {                                                       */
+/*           "cmdq_push_pop": 17.74,                                          */
+/*           ...                                                              */
+/*       },                                                                   */
+/*       "state_bytes": {                                                     */
+/*           "model": 984,                                                    */
+/*           ...                                                              */
+/*       }                                                                    */
+/*   }                                                                        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+#define BENCH_MAX_NAME     32
+#define BENCH_MAX_BASELINE 32
+
+typedef struct
+{
+    char   Name[BENCH_MAX_NAME];
+    double Value;
+} BenchValue_t;
+
+typedef struct
+{
+    unsigned long Iterations;
+    unsigned long Repeats;
+    unsigned int  NumNs;
+    BenchValue_t  Ns[BENCH_MAX_BASELINE];
+    unsigned int  NumBytes;
+    BenchValue_t  Bytes[BENCH_MAX_BASELINE];
+} BenchBaseline_t;
+
+static bool BenchBaselineLoad(const char *FileName, BenchBaseline_t *Baseline)
+{
+    FILE         *File;
+    char          Line[256];
+    char          Name[BENCH_MAX_NAME];
+    char          Section[BENCH_MAX_NAME] = "";
+    double        Value;
+    BenchValue_t *Entry;
+
+    memset(Baseline, 0, sizeof(*Baseline));
+
+    File = fopen(FileName, "r");
+    if (File == NULL)
+    {
+        perror(FileName);
+        return false;
+    }
+
+    while (fgets(Line, sizeof(Line), File) != NULL)
+    {
+        if (sscanf(Line, " \"%31[^\"]\" : %lf", Name, &Value) == 2)
+        {
+            Entry = NULL;
+            if (strcmp(Section, "ns_per_op") == 0 && Baseline->NumNs < BENCH_MAX_BASELINE)
+            {
+                Entry = &Baseline->Ns[Baseline->NumNs++];
+            }
+            else if (strcmp(Section, "state_bytes") == 0 && Baseline->NumBytes < BENCH_MAX_BASELINE)
+            {
+                Entry = &Baseline->Bytes[Baseline->NumBytes++];
+            }
+            else if (Section[0] == '\0' && strcmp(Name, "iterations") == 0)
+            {
+                Baseline->Iterations = (unsigned long)Value;
+            }
+            else if (Section[0] == '\0' && strcmp(Name, "repeats") == 0)
+            {
+                Baseline->Repeats = (unsigned long)Value;
+            }
+
+            if (Entry != NULL)
+            {
+                snprintf(Entry->Name, sizeof(Entry->Name), "%s", Name);
+                Entry->Value = Value;
+            }
+        }
+        else if (sscanf(Line, " \"%31[^\"]\" : {", Name) == 1 && strchr(Line, '{') != NULL)
+        {
+            snprintf(Section, sizeof(Section), "%s", Name);
+        }
+        else if (strchr(Line, '}') != NULL)
+        {
+            Section[0] = '\0';
+        }
+    }
+
+    fclose(File);
+
+    return true;
+}
+
+static const BenchValue_t *BenchBaselineFind(const BenchValue_t *Values, unsigned int NumValues, const char *Name)
+{
+    unsigned int i;
+
+    for (i = 0; i < NumValues; i++)
+    {
+        if (strcmp(Values[i].Name, Name) == 0)
+        {
+            return &Values[i];
+        }
+    }
+
+    return NULL;
+}
+
+static bool BenchResultsWrite(const char *FileName, unsigned long Iterations, unsigned long Repeats,
+                              const double *Cost)
+{
+    FILE  *File;
+    size_t i;
+
+    File = fopen(FileName, "w");
+    if (File == NULL)
+    {
+        perror(FileName);
+        return false;
+    }
+
+    fprintf(File, "{\n    \"iterations\": %lu,\n    \"repeats\": %lu,\n    \"ns_per_op\": {\n", Iterations, Repeats);
+    for (i = 0; i < BENCH_NUM_BENCHES; i++)
+    {
+        fprintf(File, "        \"%s\": %.2f%s\n", BenchTable[i].Name, Cost[i], (i + 1 < BENCH_NUM_BENCHES) ? "," : "");
+    }
+    fprintf(File, "    },\n    \"state_bytes\": {\n");
+    for (i = 0; i < BENCH_NUM_SIZES; i++)
+    {
+        fprintf(File, "        \"%s\": %lu%s\n", BenchSizeTable[i].Name, (unsigned long)BenchSizeTable[i].Bytes,
+                (i + 1 < BENCH_NUM_SIZES) ? "," : "");
+    }
+    fprintf(File, "    }\n}\n");
+
+    fclose(File);
+
+    return true;
+}
+
+static void BenchUsage(const char *Prog)
+{
+    fprintf(stderr,
+            "usage: %s [-n iterations] [-r repeats] [-b baseline.json] [-t threshold_pct] [-o results.json]"
+            " [iterations]\n",
+            Prog);
+}
+
+/*
+** With -b, every benchmark is compared against the baseline and the exit
+** status is non-zero if one fails or is slower by more than the threshold,
+** or any module state grew. Iterations and repeats default to the baseline's.
+*/
+int main(int argc, char *argv[])
+{
+    static BenchBaseline_t Baseline;
+    const BenchValue_t    *Base;
+    const char            *BaselineName = NULL;
+    const char            *OutputName   = NULL;
+    unsigned long          Iterations   = 0;
+    unsigned long          Repeats      = 0;
+    double                 Threshold    = BENCH_DEFAULT_THRESHOLD;
+    double                 Cost[BENCH_NUM_BENCHES];
+    double                 Sample;
+    double                 Change;
+    unsigned long          Runs;
+    unsigned long          r;
+    uint64_t               Misses;
+    unsigned int           Failures = 0;
+    unsigned int           Broken   = 0;
+    int32                  Status;
+    size_t                 i;
+    int                    opt;
+
+    while ((opt = getopt(argc, argv, "n:r:b:t:o:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'n':
+                Iterations = strtoul(optarg, NULL, 0);
+                break;
+            case 'r':
+                Repeats = strtoul(optarg, NULL, 0);
+                break;
+            case 'b':
+                BaselineName = optarg;
+                break;
+            case 't':
+                Threshold = strtod(optarg, NULL);
+                break;
+            case 'o':
+                OutputName = optarg;
+                break;
+            default:
+                BenchUsage(argv[0]);
+                return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (optind < argc)
+    {
+        Iterations = strtoul(argv[optind], NULL, 0);
+        if (Iterations == 0)
+        {
+            BenchUsage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    if (BaselineName != NULL && !BenchBaselineLoad(BaselineName, &Baseline))
+    {
+        return EXIT_FAILURE;
+    }
+    if (Iterations == 0)
+    {
+        Iterations = (Baseline.Iterations != 0) ? Baseline.Iterations : BENCH_DEFAULT_ITERATIONS;
+    }
+    if (Repeats == 0)
+    {
+        Repeats = (Baseline.Repeats != 0) ? Baseline.Repeats : 1;
+    }
+
+    /*
+    ** The app benchmarks run on the app's own state, initialized as on
+    ** the target
+    */
+    Status = RobotSimInit();
+    if (Status != CFE_SUCCESS)
+    {
+        fprintf(stderr, "RobotSimInit failed, RC = 0x%08lX\n", (unsigned long)Status);
+        return EXIT_FAILURE;
+    }
+
+    BenchMissOpen();
+
+    for (i = 0; i < BENCH_NUM_BENCHES; i++)
+    {
+        Runs = Iterations / BenchTable[i].Divisor;
+        if (Runs == 0)
+        {
+            Runs = 1;
+        }
+
+        /*
+        ** Best of the repeats, misses from the last one
+        */
+        for (r = 0; r < Repeats; r++)
+        {
+            if (BenchMissFd >= 0)
+            {
+                ioctl(BenchMissFd, PERF_EVENT_IOC_RESET, 0);
+            }
+            BenchMissEnable(true);
+            Sample = BenchTable[i].Func(Runs);
+            BenchMissEnable(false);
+
+            if (Sample < 0.0)
+            {
+                Cost[i] = BENCH_FAILED;
+                break;
+            }
+            if (r == 0 || Sample < Cost[i])
+            {
+                Cost[i] = Sample;
+            }
+        }
+        Misses = BenchMissRead();
+
+        if (Cost[i] < 0.0)
+        {
+            printf("%-24s FAILED\n", BenchTable[i].Name);
+            Failures++;
+            Broken++;
+            continue;
+        }
+
+        if (BenchMissFd >= 0)
+        {
+            printf("%-24s %10.2f ns/op %10.2f L1D misses/op", BenchTable[i].Name, Cost[i],
+                   (double)Misses / (double)Runs);
+        }
+        else
+        {
+            printf("%-24s %10.2f ns/op %10s L1D misses/op", BenchTable[i].Name, Cost[i], "n/a");
+        }
+
+        Base = BenchBaselineFind(Baseline.Ns, Baseline.NumNs, BenchTable[i].Name);
+        if (Base != NULL && Base->Value > 0.0)
+        {
+            Change = 100.0 * (Cost[i] - Base->Value) / Base->Value;
+            printf(" %+8.1f%%%s", Change, (Change > Threshold) ? " REGRESSED" : "");
+            Failures += (Change > Threshold) ? 1 : 0;
+        }
+        else if (BaselineName != NULL)
+        {
+            printf("      new");
+        }
+        printf("\n");
+    }
+
+    if (BenchMissFd >= 0)
+    {
+        close(BenchMissFd);
+    }
+
+    for (i = 0; i < BENCH_NUM_SIZES; i++)
+    {
+        printf("%-24s %10lu bytes", BenchSizeTable[i].Name, (unsigned long)BenchSizeTable[i].Bytes);
+
+        Base = BenchBaselineFind(Baseline.Bytes, Baseline.NumBytes, BenchSizeTable[i].Name);
+        if (Base != NULL)
+        {
+            printf(" %+8ld%s", (long)BenchSizeTable[i].Bytes - (long)Base->Value,
+                   ((double)BenchSizeTable[i].Bytes > Base->Value) ? " GREW" : "");
+            Failures += ((double)BenchSizeTable[i].Bytes > Base->Value) ? 1 : 0;
+        }
+        else if (BaselineName != NULL)
+        {
+            printf("      new");
+        }
+        printf("\n");
+    }
+
+    if (OutputName != NULL && Broken != 0)
+    {
+        fprintf(stderr, "%s: not written, %u benchmark%s failed\n", OutputName, Broken, (Broken == 1) ? "" : "s");
+        return EXIT_FAILURE;
+    }
+    if (OutputName != NULL && !BenchResultsWrite(OutputName, Iterations, Repeats, Cost))
+    {
+        return EXIT_FAILURE;
+    }
+
+    if (BaselineName != NULL)
+    {
+        printf("%u regression%s against %s (threshold %.0f%%)\n", Failures, (Failures == 1) ? "" : "s", BaselineName,
+               Threshold);
+    }
+
+    return (Failures == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
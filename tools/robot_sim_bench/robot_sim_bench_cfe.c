@@ -0,0 +1,399 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_bench_cfe.c
+**
+** Purpose:
+**   Host implementation of the cFE and OSAL subset declared in host_inc,
+**   enough to run the robot sim app's own init, command dispatch and
+**   high rate loop in the host tools. There is no software bus: sent
+**   messages and events are dropped without formatting, so benchmarks
+**   of app paths exclude the SB and EVS costs the target adds on top.
+**   The table load takes the default image compiled from
+**   fsw/tables/robot_sim_tbl.c and runs the app's validation on it.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "cfe.h"
+#include "robot_sim_table.h"
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+extern RobotSimTable_t RobotSimTable;
+
+#define BENCH_CFE_PRI_HDR_BYTES 6
+#define BENCH_CFE_TBL_HANDLE    1
+#define BENCH_CFE_FS_CONTENT    0x63464531 /* 'cFE1' */
+
+static void BenchCfePut16(uint8 *Dst, uint32 Value)
+{
+    Dst[0] = (uint8)(Value >> 8);
+    Dst[1] = (uint8)Value;
+}
+
+static uint32 BenchCfeGet16(const uint8 *Src)
+{
+    return ((uint32)Src[0] << 8) | (uint32)Src[1];
+}
+
+/*
+** PSP and TIME
+*/
+void CFE_PSP_GetTime(OS_time_t *LocalTime)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    LocalTime->ticks = (int64)ts.tv_sec * 10000000 + (int64)(ts.tv_nsec / 100);
+}
+
+CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+    CFE_TIME_SysTime_t Now;
+    struct timespec    ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+    Now.Seconds    = (uint32)ts.tv_sec;
+    Now.Subseconds = (uint32)(((uint64)ts.tv_nsec << 32) / 1000000000ULL);
+
+    return Now;
+}
+
+OS_time_t OS_TimeSubtract(OS_time_t time1, OS_time_t time2)
+{
+    OS_time_t Diff;
+
+    Diff.ticks = time1.ticks - time2.ticks;
+
+    return Diff;
+}
+
+int64 OS_TimeGetTotalMicroseconds(OS_time_t tm)
+{
+    return tm.ticks / 10;
+}
+
+/*
+** OSAL files, ids are the POSIX descriptor plus one
+*/
+int32 OS_OpenCreate(osal_id_t *filedes, const char *path, int32 flags, int32 access_mode)
+{
+    int Mode = (access_mode == OS_READ_ONLY) ? O_RDONLY : (access_mode == OS_WRITE_ONLY) ? O_WRONLY : O_RDWR;
+    int Fd;
+
+    Mode |= (flags & OS_FILE_FLAG_CREATE) ? O_CREAT : 0;
+    Mode |= (flags & OS_FILE_FLAG_TRUNCATE) ? O_TRUNC : 0;
+
+    Fd = open(path, Mode, 0644);
+    if (Fd < 0)
+    {
+        return OS_ERROR;
+    }
+    *filedes = (osal_id_t)Fd + 1;
+
+    return OS_SUCCESS;
+}
+
+int32 OS_write(osal_id_t filedes, const void *buffer, size_t nbytes)
+{
+    ssize_t Written = write((int)filedes - 1, buffer, nbytes);
+
+    return (Written < 0) ? OS_ERROR : (int32)Written;
+}
+
+int32 OS_close(osal_id_t filedes)
+{
+    return (close((int)filedes - 1) == 0) ? OS_SUCCESS : OS_ERROR;
+}
+
+void OS_printf(const char *string, ...)
+{
+    va_list Args;
+
+    va_start(Args, string);
+    vprintf(string, Args);
+    va_end(Args);
+}
+
+/*
+** ES; the syslog is dropped, callers report their own failures
+*/
+void CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit)
+{
+    (void)Marker;
+    (void)EntryExit;
+}
+
+bool CFE_ES_RunLoop(uint32 *RunStatus)
+{
+    return (RunStatus != NULL && *RunStatus == CFE_ES_RunStatus_APP_RUN);
+}
+
+void CFE_ES_ExitApp(uint32 ExitStatus)
+{
+    exit((ExitStatus == CFE_ES_RunStatus_APP_EXIT) ? EXIT_SUCCESS : EXIT_FAILURE);
+}
+
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+    (void)SpecStringPtr;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** EVS
+*/
+int32 CFE_EVS_Register(const void *Filters, uint16 NumEventFilters, uint16 FilterScheme)
+{
+    (void)Filters;
+    (void)NumEventFilters;
+    (void)FilterScheme;
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+    (void)EventID;
+    (void)EventType;
+    (void)Spec;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** MSG, CCSDS primary header with the length field holding size - 7
+*/
+int32 CFE_MSG_Init(CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t MsgId, CFE_MSG_Size_t Size)
+{
+    if (MsgPtr == NULL || Size < BENCH_CFE_PRI_HDR_BYTES + 1 || !CFE_SB_IsValidMsgId(MsgId))
+    {
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+
+    memset(MsgPtr, 0, Size);
+    BenchCfePut16(&MsgPtr->Byte[0], MsgId);
+    BenchCfePut16(&MsgPtr->Byte[2], 0xC000);
+    BenchCfePut16(&MsgPtr->Byte[4], (uint32)(Size - 7));
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetMsgId(const CFE_MSG_Message_t *MsgPtr, CFE_SB_MsgId_t *MsgId)
+{
+    *MsgId = CFE_SB_ValueToMsgId(BenchCfeGet16(&MsgPtr->Byte[0]));
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetSize(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_Size_t *Size)
+{
+    *Size = BenchCfeGet16(&MsgPtr->Byte[4]) + 7;
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_GetFcnCode(const CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t *FcnCode)
+{
+    *FcnCode = ((const CFE_MSG_CommandHeader_t *)MsgPtr)->FunctionCode & 0x7F;
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_MSG_SetFcnCode(CFE_MSG_Message_t *MsgPtr, CFE_MSG_FcnCode_t FcnCode)
+{
+    if (FcnCode > 0x7F)
+    {
+        return CFE_STATUS_VALIDATION_FAILURE;
+    }
+    ((CFE_MSG_CommandHeader_t *)MsgPtr)->FunctionCode = (uint8)FcnCode;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** SB; nothing is ever received and everything sent is dropped
+*/
+int32 CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16 Depth, const char *PipeName)
+{
+    (void)Depth;
+    (void)PipeName;
+    *PipeIdPtr = 1;
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_Subscribe(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId)
+{
+    (void)MsgId;
+    (void)PipeId;
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_SB_ReceiveBuffer(CFE_SB_Buffer_t **BufPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+    (void)PipeId;
+    (void)TimeOut;
+    *BufPtr = NULL;
+
+    return CFE_SB_NO_MESSAGE;
+}
+
+void CFE_SB_TimeStampMsg(CFE_MSG_Message_t *MsgPtr)
+{
+    CFE_MSG_TelemetryHeader_t *Hdr = (CFE_MSG_TelemetryHeader_t *)MsgPtr;
+    CFE_TIME_SysTime_t         Now = CFE_TIME_GetTime();
+
+    Hdr->Time[0] = (uint8)(Now.Seconds >> 24);
+    Hdr->Time[1] = (uint8)(Now.Seconds >> 16);
+    Hdr->Time[2] = (uint8)(Now.Seconds >> 8);
+    Hdr->Time[3] = (uint8)Now.Seconds;
+    BenchCfePut16(&Hdr->Time[4], Now.Subseconds >> 16);
+}
+
+int32 CFE_SB_TransmitMsg(CFE_MSG_Message_t *MsgPtr, bool IncrementSequenceCount)
+{
+    (void)MsgPtr;
+    (void)IncrementSequenceCount;
+
+    return CFE_SUCCESS;
+}
+
+/*
+** TBL, a single table that the app loads from its default image
+*/
+static struct
+{
+    CFE_TBL_CallbackFuncPtr_t Validate;
+    bool                      Registered;
+    bool                      Loaded;
+    bool                      Updated;
+    RobotSimTable_t           Buffer;
+} BenchCfeTbl;
+
+int32 CFE_TBL_Register(CFE_TBL_Handle_t *TblHandlePtr, const char *Name, size_t Size, uint16 TblOptionFlags,
+                       CFE_TBL_CallbackFuncPtr_t TblValidationFuncPtr)
+{
+    (void)Name;
+    (void)TblOptionFlags;
+
+    if (BenchCfeTbl.Registered || Size != sizeof(BenchCfeTbl.Buffer))
+    {
+        return CFE_TBL_ERR_INVALID_HANDLE;
+    }
+    BenchCfeTbl.Validate   = TblValidationFuncPtr;
+    BenchCfeTbl.Registered = true;
+    *TblHandlePtr          = BENCH_CFE_TBL_HANDLE;
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_Load(CFE_TBL_Handle_t TblHandle, CFE_TBL_SrcEnum_t SrcType, const void *SrcDataPtr)
+{
+    static RobotSimTable_t Staged;
+    int32                  status;
+
+    if (TblHandle != BENCH_CFE_TBL_HANDLE || !BenchCfeTbl.Registered)
+    {
+        return CFE_TBL_ERR_INVALID_HANDLE;
+    }
+
+    Staged = (SrcType == CFE_TBL_SRC_FILE) ? RobotSimTable : *(const RobotSimTable_t *)SrcDataPtr;
+    if (BenchCfeTbl.Validate != NULL)
+    {
+        status = BenchCfeTbl.Validate(&Staged);
+        if (status != CFE_SUCCESS)
+        {
+            return status;
+        }
+    }
+    BenchCfeTbl.Buffer  = Staged;
+    BenchCfeTbl.Loaded  = true;
+    BenchCfeTbl.Updated = true;
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_GetAddress(void **TblPtr, CFE_TBL_Handle_t TblHandle)
+{
+    if (TblHandle != BENCH_CFE_TBL_HANDLE || !BenchCfeTbl.Loaded)
+    {
+        return CFE_TBL_ERR_INVALID_HANDLE;
+    }
+    *TblPtr = &BenchCfeTbl.Buffer;
+
+    if (BenchCfeTbl.Updated)
+    {
+        BenchCfeTbl.Updated = false;
+        return CFE_TBL_INFO_UPDATED;
+    }
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_ReleaseAddress(CFE_TBL_Handle_t TblHandle)
+{
+    return (TblHandle == BENCH_CFE_TBL_HANDLE) ? CFE_SUCCESS : CFE_TBL_ERR_INVALID_HANDLE;
+}
+
+int32 CFE_TBL_Manage(CFE_TBL_Handle_t TblHandle)
+{
+    return (TblHandle == BENCH_CFE_TBL_HANDLE) ? CFE_SUCCESS : CFE_TBL_ERR_INVALID_HANDLE;
+}
+
+/*
+** FS, header written big endian as on the target
+*/
+void CFE_FS_InitHeader(CFE_FS_Header_t *Hdr, const char *Description, uint32 SubType)
+{
+    memset(Hdr, 0, sizeof(*Hdr));
+    strncpy(Hdr->Description, Description, sizeof(Hdr->Description) - 1);
+    Hdr->ContentType = BENCH_CFE_FS_CONTENT;
+    Hdr->SubType     = SubType;
+}
+
+int32 CFE_FS_WriteHeader(osal_id_t FileDes, CFE_FS_Header_t *Hdr)
+{
+    CFE_TIME_SysTime_t Now = CFE_TIME_GetTime();
+    CFE_FS_Header_t    Out = *Hdr;
+
+    Out.ContentType    = htonl(Hdr->ContentType);
+    Out.SubType        = htonl(Hdr->SubType);
+    Out.Length         = htonl(sizeof(Out));
+    Out.SpacecraftID   = htonl(Hdr->SpacecraftID);
+    Out.ProcessorID    = htonl(Hdr->ProcessorID);
+    Out.ApplicationID  = htonl(Hdr->ApplicationID);
+    Out.TimeSeconds    = htonl(Now.Seconds);
+    Out.TimeSubSeconds = htonl(Now.Subseconds);
+
+    return OS_write(FileDes, &Out, sizeof(Out));
+}
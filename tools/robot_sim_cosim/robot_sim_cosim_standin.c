@@ -0,0 +1,177 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_cosim_standin.c
+**
+** Purpose:
+**   Stand-in for an external physics engine. Listens on a Unix socket and
+**   answers the robot sim co-simulation backend with the same
+**   rate-limited kinematic integration the app runs internally, so a
+**   lockstep run should track an internal one.
+**
+** Notes:
+**   An optional per-step delay emulates a slower engine, to exercise the
+**   backend's timeout.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_cosim.h"
+#include "robot_sim_model.h"
+#include "robot_sim_table.h"
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#define STANDIN_DEFAULT_PATH "/tmp/robot_sim_cosim.sock"
+
+/*
+** Joint limits, compiled from fsw/tables/robot_sim_tbl.c
+*/
+extern RobotSimTable_t RobotSimTable;
+
+typedef struct
+{
+    RobotSimModel_t Model;
+    unsigned int    DelayUsec;
+    unsigned long   Steps;
+} StandIn_t;
+
+static void StandInHandler(void *Arg, const RobotSimCosimMsg_t *Request, RobotSimCosimMsg_t *Reply)
+{
+    StandIn_t       *StandIn = Arg;
+    RobotSimModel_t *Model   = &StandIn->Model;
+    float            Dt      = Request->Dt;
+    int              i;
+
+    if (Request->Type == ROBOT_SIM_COSIM_SYNC)
+    {
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Model->Position[i] = Request->Position[i];
+            Model->Applied[i]  = Request->Rate[i] * Dt;
+        }
+    }
+    else
+    {
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Model->Command[i]    = Request->Rate[i] * Dt;
+            Model->AccelLimit[i] = Request->AccelLimit[i] * Dt * Dt;
+        }
+        RobotSimModelPhysics(Model);
+        StandIn->Steps++;
+
+        if (StandIn->DelayUsec != 0)
+        {
+            usleep(StandIn->DelayUsec);
+        }
+    }
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Reply->Position[i] = Model->Position[i];
+        Reply->Rate[i]     = Model->Applied[i] / Dt;
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    static StandIn_t   StandIn;
+    struct sockaddr_un Addr;
+    const char        *Path = STANDIN_DEFAULT_PATH;
+    float              Min[NUM_JOINTS];
+    float              Max[NUM_JOINTS];
+    int                Listener;
+    int                Fd;
+    int                i;
+
+    if (argc > 3)
+    {
+        fprintf(stderr, "usage: %s [socket path] [step delay usec]\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+    if (argc > 1)
+    {
+        Path = argv[1];
+    }
+    if (argc > 2)
+    {
+        StandIn.DelayUsec = (unsigned int)strtoul(argv[2], NULL, 0);
+    }
+
+    RobotSimModelInit(&StandIn.Model, 0.0f);
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Min[i] = RobotSimTable.Joints[i].MinAngle;
+        Max[i] = RobotSimTable.Joints[i].MaxAngle;
+    }
+    RobotSimModelSetLimits(&StandIn.Model, Min, Max);
+
+    memset(&Addr, 0, sizeof(Addr));
+    Addr.sun_family = AF_UNIX;
+    if (strlen(Path) >= sizeof(Addr.sun_path))
+    {
+        fprintf(stderr, "socket path too long: %s\n", Path);
+        return EXIT_FAILURE;
+    }
+    strcpy(Addr.sun_path, Path);
+
+    Listener = socket(AF_UNIX, SOCK_SEQPACKET, 0);
+    unlink(Path);
+    if (Listener < 0 || bind(Listener, (struct sockaddr *)&Addr, sizeof(Addr)) != 0 || listen(Listener, 1) != 0)
+    {
+        perror(Path);
+        return EXIT_FAILURE;
+    }
+
+    printf("robot sim physics stand-in listening on %s\n", Path);
+
+    /*
+    ** One client at a time; the arm keeps its state between clients
+    */
+    for (;;)
+    {
+        Fd = accept(Listener, NULL, NULL);
+        if (Fd < 0)
+        {
+            perror("accept");
+            continue;
+        }
+
+        StandIn.Steps = 0;
+        if (RobotSimCosimServe(Fd, StandInHandler, &StandIn) != ROBOT_SIM_COSIM_OK)
+        {
+            fprintf(stderr, "protocol error, dropping client\n");
+        }
+        printf("client left after %lu steps\n", StandIn.Steps);
+        fflush(stdout);
+
+        close(Fd);
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,291 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_cosim_test.c
+**
+** Purpose:
+**   Runs the co-simulation backend against the physics stand-in on a
+**   private socket: a lockstep run must track the internal physics, and a
+**   stand-in slower than the backend timeout must be reported as a timeout
+**   without its late reply being taken for the next one.
+**
+** Notes:
+**   The stand-in executable is the only argument.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_cosim.h"
+#include "robot_sim_model.h"
+#include "robot_sim_table.h"
+
+#include <math.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#define TEST_TICKS         2000
+#define TEST_DT            1.0e-3f /* Seconds per physics tick */
+#define TEST_ACCEL         2.0f    /* rad/s^2 */
+#define TEST_TIMEOUT_MSEC  20
+#define TEST_SLOW_USEC     200000 /* Stand-in step delay, well past the timeout */
+#define TEST_CONNECT_TRIES 200    /* 10 ms apart, while the stand-in binds */
+
+/*
+** Joint limits and gains, compiled from fsw/tables/robot_sim_tbl.c
+*/
+extern RobotSimTable_t RobotSimTable;
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* TestStartStandIn() -- run the stand-in on Path and connect to it           */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static pid_t TestStartStandIn(RobotSimCosim_t *Link, const char *Exe, const char *Path, unsigned int DelayUsec)
+{
+    char  Delay[16];
+    pid_t Pid;
+    int   Try;
+
+    snprintf(Delay, sizeof(Delay), "%u", DelayUsec);
+
+    Pid = fork();
+    if (Pid == 0)
+    {
+        execl(Exe, Exe, Path, Delay, (char *)NULL);
+        perror(Exe);
+        _exit(127);
+    }
+    if (Pid < 0)
+    {
+        perror("fork");
+        return -1;
+    }
+
+    for (Try = 0; Try < TEST_CONNECT_TRIES; Try++)
+    {
+        if (RobotSimCosimConnect(Link, Path, TEST_DT, TEST_TIMEOUT_MSEC) == ROBOT_SIM_COSIM_OK)
+        {
+            return Pid;
+        }
+        usleep(10000);
+    }
+
+    fprintf(stderr, "robot_sim_cosim_test: no stand-in on %s\n", Path);
+    kill(Pid, SIGTERM);
+    waitpid(Pid, NULL, 0);
+    return -1;
+}
+
+static void TestStopStandIn(RobotSimCosim_t *Link, pid_t Pid)
+{
+    RobotSimCosimClose(Link);
+    kill(Pid, SIGTERM);
+    waitpid(Pid, NULL, 0);
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* TestLockstep() -- lockstep and internal physics from the same state        */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int TestLockstep(RobotSimCosim_t *Link)
+{
+    static const float     Start[NUM_JOINTS] = {0.3f, -0.5f, 0.7f, 1.1f, -0.4f, 0.2f, 0.9f};
+    static const float     Goal[NUM_JOINTS]  = {-0.6f, 0.4f, 1.5f, -0.2f, 0.8f, -1.0f, 0.0f};
+    static const float     Torque[NUM_JOINTS];
+    static RobotSimModel_t Lockstep;
+    static RobotSimModel_t Internal;
+    float                  AccelLimit[NUM_JOINTS];
+    float                  Worst = 0.0f;
+    float                  Moved = 0.0f;
+    int32_t                status;
+    int                    t;
+    int                    i;
+
+    RobotSimModelInit(&Lockstep, 0.0f);
+    RobotSimModelApplyTable(&Lockstep, &RobotSimTable, TEST_DT);
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Lockstep.Position[i] = Start[i];
+        AccelLimit[i]        = TEST_ACCEL * TEST_DT * TEST_DT;
+    }
+    RobotSimModelSetAccelLimit(&Lockstep, AccelLimit);
+    RobotSimModelSetGoal(&Lockstep, Goal);
+
+    status = RobotSimCosimSync(Link, &Lockstep);
+    if (status != ROBOT_SIM_COSIM_OK)
+    {
+        printf("robot_sim_cosim_test: sync failed, status %d\n", (int)status);
+        return -1;
+    }
+    Internal = Lockstep;
+
+    for (t = 0; t < TEST_TICKS; t++)
+    {
+        RobotSimModelControl(&Lockstep);
+        status = RobotSimCosimStep(Link, &Lockstep, Torque);
+        if (status != ROBOT_SIM_COSIM_OK)
+        {
+            printf("robot_sim_cosim_test: step %d failed, status %d\n", t, (int)status);
+            return -1;
+        }
+
+        RobotSimModelControl(&Internal);
+        RobotSimModelPhysics(&Internal);
+
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            if (fabsf(Lockstep.Position[i] - Internal.Position[i]) > Worst)
+            {
+                Worst = fabsf(Lockstep.Position[i] - Internal.Position[i]);
+            }
+        }
+    }
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        if (fabsf(Internal.Position[i] - Start[i]) > Moved)
+        {
+            Moved = fabsf(Internal.Position[i] - Start[i]);
+        }
+    }
+
+    printf("robot_sim_cosim_test: %lu lockstep steps, arm moved %g rad, worst deviation %g rad, max round trip %lu "
+           "usec\n",
+           (unsigned long)Link->StepCount, (double)Moved, (double)Worst, (unsigned long)Link->MaxRoundTripUsec);
+
+    /*
+    ** Rates cross the link in rad/s, so allow for rounding, not for drift
+    */
+    if (Link->StepCount != TEST_TICKS || Moved < 0.1f || Worst > 1.0e-4f)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* TestTimeout() -- a step the stand-in answers too late                      */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int TestTimeout(RobotSimCosim_t *Link)
+{
+    static const float     Torque[NUM_JOINTS];
+    static RobotSimModel_t Model;
+    int32_t                Timeout;
+    int32_t                Late;
+
+    RobotSimModelInit(&Model, 0.0f);
+    RobotSimModelApplyTable(&Model, &RobotSimTable, TEST_DT);
+
+    /*
+    ** The stand-in only delays steps, so the sync still goes through
+    */
+    if (RobotSimCosimSync(Link, &Model) != ROBOT_SIM_COSIM_OK)
+    {
+        printf("robot_sim_cosim_test: sync with the slow stand-in failed\n");
+        return -1;
+    }
+
+    Timeout = RobotSimCosimStep(Link, &Model, Torque);
+
+    /*
+    ** Wait long enough for the late reply, which must not pass for this one
+    */
+    Link->TimeoutMsec = 4 * TEST_SLOW_USEC / 1000;
+    Late              = RobotSimCosimStep(Link, &Model, Torque);
+
+    printf("robot_sim_cosim_test: slow step status %d, next step status %d\n", (int)Timeout, (int)Late);
+
+    if (Timeout != ROBOT_SIM_COSIM_TIMEOUT || Late != ROBOT_SIM_COSIM_ERROR || Link->StepCount != 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+int main(int argc, char *argv[])
+{
+    static RobotSimCosim_t Link;
+    char                   Dir[] = "/tmp/robot_sim_cosim_XXXXXX";
+    char                   Path[sizeof(Dir) + 16];
+    pid_t                  Pid;
+    int                    Failed = 0;
+
+    if (argc != 2)
+    {
+        fprintf(stderr, "usage: %s stand-in\n", argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    /*
+    ** A killed stand-in would otherwise end the test on the next send
+    */
+    signal(SIGPIPE, SIG_IGN);
+
+    if (mkdtemp(Dir) == NULL)
+    {
+        perror(Dir);
+        return EXIT_FAILURE;
+    }
+    snprintf(Path, sizeof(Path), "%s/physics.sock", Dir);
+
+    RobotSimCosimInit(&Link);
+
+    Pid = TestStartStandIn(&Link, argv[1], Path, 0);
+    if (Pid < 0 || TestLockstep(&Link) != 0)
+    {
+        Failed = 1;
+    }
+    if (Pid > 0)
+    {
+        TestStopStandIn(&Link, Pid);
+    }
+
+    Pid = TestStartStandIn(&Link, argv[1], Path, TEST_SLOW_USEC);
+    if (Pid < 0 || TestTimeout(&Link) != 0)
+    {
+        Failed = 1;
+    }
+    if (Pid > 0)
+    {
+        TestStopStandIn(&Link, Pid);
+    }
+
+    unlink(Path);
+    rmdir(Dir);
+
+    if (Failed)
+    {
+        printf("robot_sim_cosim_test: FAILED\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
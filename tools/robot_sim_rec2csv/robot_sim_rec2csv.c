@@ -0,0 +1,272 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+** File: robot_sim_rec2csv.c
+**
+** Purpose:
+**   Converts a robot sim state recorder dump to CSV, or to one flat binary
+**   file per column for loading into columnar tools (numpy.fromfile,
+**   pyarrow, etc).
+**
+** Notes:
+**   Must run on a host with the same byte order as the flight processor.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_rec_format.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+** Size of the cFE file header that precedes the recorder header
+*/
+#define REC2CSV_FS_HDR_SIZE 64
+
+typedef struct
+{
+    const char *Name;
+    size_t      Offset; /**< Within RobotSimRecRecord_t */
+    int         IsFloat;
+} Rec2CsvColumn_t;
+
+static Rec2CsvColumn_t Rec2CsvColumns[3 + 3 * NUM_JOINTS];
+static char            Rec2CsvNames[3 * NUM_JOINTS][16];
+static int             Rec2CsvNumColumns;
+
+static void Rec2CsvAddColumn(const char *Name, size_t Offset, int IsFloat)
+{
+    Rec2CsvColumns[Rec2CsvNumColumns].Name    = Name;
+    Rec2CsvColumns[Rec2CsvNumColumns].Offset  = Offset;
+    Rec2CsvColumns[Rec2CsvNumColumns].IsFloat = IsFloat;
+    Rec2CsvNumColumns++;
+}
+
+static void Rec2CsvBuildColumns(void)
+{
+    int j;
+
+    Rec2CsvAddColumn("sequence", offsetof(RobotSimRecRecord_t, Sequence), 0);
+    Rec2CsvAddColumn("seconds", offsetof(RobotSimRecRecord_t, Seconds), 0);
+    Rec2CsvAddColumn("subseconds", offsetof(RobotSimRecRecord_t, Subseconds), 0);
+
+    for (j = 0; j < NUM_JOINTS; j++)
+    {
+        snprintf(Rec2CsvNames[j], sizeof(Rec2CsvNames[j]), "position%d", j);
+        snprintf(Rec2CsvNames[NUM_JOINTS + j], sizeof(Rec2CsvNames[0]), "goal%d", j);
+        snprintf(Rec2CsvNames[2 * NUM_JOINTS + j], sizeof(Rec2CsvNames[0]), "error%d", j);
+    }
+    for (j = 0; j < NUM_JOINTS; j++)
+    {
+        Rec2CsvAddColumn(Rec2CsvNames[j], offsetof(RobotSimRecRecord_t, Position) + j * sizeof(float), 1);
+    }
+    for (j = 0; j < NUM_JOINTS; j++)
+    {
+        Rec2CsvAddColumn(Rec2CsvNames[NUM_JOINTS + j], offsetof(RobotSimRecRecord_t, Goal) + j * sizeof(float), 1);
+    }
+    for (j = 0; j < NUM_JOINTS; j++)
+    {
+        Rec2CsvAddColumn(Rec2CsvNames[2 * NUM_JOINTS + j], offsetof(RobotSimRecRecord_t, Error) + j * sizeof(float),
+                         1);
+    }
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Rec2CsvWriteCsv() -- one row per sample                                    */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int Rec2CsvWriteCsv(FILE *Out, const RobotSimRecFileHdr_t *Hdr, const RobotSimRecRecord_t *Records)
+{
+    const unsigned char *Base;
+    uint32_t             i;
+    int                  c;
+    float                f;
+    uint32_t             u;
+
+    fprintf(Out, "trigger");
+    for (c = 0; c < Rec2CsvNumColumns; c++)
+    {
+        fprintf(Out, ",%s", Rec2CsvColumns[c].Name);
+    }
+    fputc('\n', Out);
+
+    for (i = 0; i < Hdr->NumRecords; i++)
+    {
+        Base = (const unsigned char *)&Records[i];
+        fprintf(Out, "%d", (i == Hdr->TriggerIndex) ? 1 : 0);
+
+        for (c = 0; c < Rec2CsvNumColumns; c++)
+        {
+            if (Rec2CsvColumns[c].IsFloat)
+            {
+                memcpy(&f, Base + Rec2CsvColumns[c].Offset, sizeof(f));
+                fprintf(Out, ",%.9g", f);
+            }
+            else
+            {
+                memcpy(&u, Base + Rec2CsvColumns[c].Offset, sizeof(u));
+                fprintf(Out, ",%lu", (unsigned long)u);
+            }
+        }
+        fputc('\n', Out);
+    }
+
+    return ferror(Out) ? -1 : 0;
+}
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+/*                                                                            */
+/* Rec2CsvWriteColumns() -- one raw file per column, <prefix>_<name>.<type>   */
+/*                                                                            */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * **/
+static int Rec2CsvWriteColumns(const char *Prefix, const RobotSimRecFileHdr_t *Hdr,
+                               const RobotSimRecRecord_t *Records)
+{
+    char     Path[1024];
+    FILE    *Out;
+    uint32_t i;
+    int      c;
+
+    for (c = 0; c < Rec2CsvNumColumns; c++)
+    {
+        snprintf(Path, sizeof(Path), "%s_%s.%s", Prefix, Rec2CsvColumns[c].Name,
+                 Rec2CsvColumns[c].IsFloat ? "f32" : "u32");
+
+        Out = fopen(Path, "wb");
+        if (Out == NULL)
+        {
+            perror(Path);
+            return -1;
+        }
+
+        for (i = 0; i < Hdr->NumRecords; i++)
+        {
+            fwrite((const unsigned char *)&Records[i] + Rec2CsvColumns[c].Offset, 4, 1, Out);
+        }
+
+        if (fclose(Out) != 0)
+        {
+            perror(Path);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static void Rec2CsvUsage(const char *Prog)
+{
+    fprintf(stderr, "usage: %s [-c column_prefix] dump_file [out.csv]\n", Prog);
+}
+
+int main(int argc, char *argv[])
+{
+    RobotSimRecFileHdr_t Hdr;
+    RobotSimRecRecord_t *Records;
+    const char          *Prefix = NULL;
+    FILE                *In;
+    FILE                *Out;
+    int                  opt;
+    int                  status;
+
+    while ((opt = getopt(argc, argv, "c:h")) != -1)
+    {
+        switch (opt)
+        {
+            case 'c':
+                Prefix = optarg;
+                break;
+            default:
+                Rec2CsvUsage(argv[0]);
+                return (opt == 'h') ? EXIT_SUCCESS : EXIT_FAILURE;
+        }
+    }
+    if (optind >= argc)
+    {
+        Rec2CsvUsage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    In = fopen(argv[optind], "rb");
+    if (In == NULL)
+    {
+        perror(argv[optind]);
+        return EXIT_FAILURE;
+    }
+
+    if (fseek(In, REC2CSV_FS_HDR_SIZE, SEEK_SET) != 0 || fread(&Hdr, sizeof(Hdr), 1, In) != 1 ||
+        Hdr.Magic != ROBOT_SIM_REC_MAGIC)
+    {
+        fprintf(stderr, "%s: not a robot sim recorder dump\n", argv[optind]);
+        fclose(In);
+        return EXIT_FAILURE;
+    }
+    if (Hdr.Version != ROBOT_SIM_REC_VERSION || Hdr.NumJoints != NUM_JOINTS ||
+        Hdr.RecordSize != sizeof(RobotSimRecRecord_t))
+    {
+        fprintf(stderr, "%s: unsupported dump (version %u, %u joints, %lu byte records)\n", argv[optind],
+                (unsigned int)Hdr.Version, (unsigned int)Hdr.NumJoints, (unsigned long)Hdr.RecordSize);
+        fclose(In);
+        return EXIT_FAILURE;
+    }
+
+    Records = calloc(Hdr.NumRecords ? Hdr.NumRecords : 1, sizeof(*Records));
+    if (Records == NULL || fread(Records, sizeof(*Records), Hdr.NumRecords, In) != Hdr.NumRecords)
+    {
+        fprintf(stderr, "%s: truncated dump\n", argv[optind]);
+        free(Records);
+        fclose(In);
+        return EXIT_FAILURE;
+    }
+    fclose(In);
+
+    Rec2CsvBuildColumns();
+
+    if (Prefix != NULL)
+    {
+        status = Rec2CsvWriteColumns(Prefix, &Hdr, Records);
+    }
+    else
+    {
+        Out = (optind + 1 < argc) ? fopen(argv[optind + 1], "w") : stdout;
+        if (Out == NULL)
+        {
+            perror(argv[optind + 1]);
+            free(Records);
+            return EXIT_FAILURE;
+        }
+        status = Rec2CsvWriteCsv(Out, &Hdr, Records);
+        if (Out != stdout)
+        {
+            fclose(Out);
+        }
+    }
+
+    free(Records);
+
+    return (status == 0) ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,145 @@
+/*******************************************************************************
+**
+**      GSC-18128-1, "Core Flight Executive Version 6.7"
+**
+**      Copyright (c) 2006-2019 United States Government as represented by
+**      the Administrator of the National Aeronautics and Space Administration.
+**      All Rights Reserved.
+**
+**      Licensed under the Apache License, Version 2.0 (the "License");
+**      you may not use this file except in compliance with the License.
+**      You may obtain a copy of the License at
+**
+**        http://www.apache.org/licenses/LICENSE-2.0
+**
+**      Unless required by applicable law or agreed to in writing, software
+**      distributed under the License is distributed on an "AS IS" BASIS,
+**      WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+**      See the License for the specific language governing permissions and
+**      limitations under the License.
+**
+**
+** File: robot_sim_vel_test.c
+**
+** Purpose:
+**   Checks that velocity mode never moves a joint faster than its table
+**   rate limit, even for a twist far out of range that drives the arm
+**   toward its stretched-out singularity, and that the limit keeps the
+**   direction of the joint motion.
+**
+*******************************************************************************/
+
+/*
+** Include Files:
+*/
+#include "robot_sim_model.h"
+#include "robot_sim_kin.h"
+#include "robot_sim_vel.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define TEST_TICKS 2000
+#define TEST_DT    1.0e-3f /* Seconds per physics tick */
+
+/*
+** Default kinematic model, compiled from fsw/tables/robot_sim_tbl.c
+*/
+extern RobotSimTable_t RobotSimTable;
+
+int main(void)
+{
+    static const RobotSimVelConfig_t Config  = {5.0f, 1.0e-4f, 50.0f, 400.0f};
+    static const float               Twist[6] = {100.0f, -50.0f, 80.0f, 10.0f, -10.0f, 20.0f};
+    static RobotSimModel_t           Model;
+    static RobotSimKin_t             Kin;
+    static RobotSimVel_t             Vel;
+    static const float               Start[NUM_JOINTS] = {0.3f, -0.5f, 0.7f, 1.1f, -0.4f, 0.2f, 0.9f};
+    float                            Increment[NUM_JOINTS];
+    float                            Before[NUM_JOINTS];
+    float                            Step;
+    float                            Limit;
+    float                            Ratio;
+    float                            WorstOver = 0.0f;
+    float                            WorstBend = 0.0f;
+    int                              Saturated = 0;
+    int                              t;
+    int                              i;
+
+    RobotSimModelInit(&Model, 0.01f);
+    RobotSimModelSetGoal(&Model, Start);
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Model.Position[i] = Start[i];
+    }
+    RobotSimKinInit(&Kin, &RobotSimTable);
+    RobotSimVelInit(&Vel, &Config);
+    RobotSimVelSetTwist(&Vel, Twist);
+
+    for (i = 0; i < NUM_JOINTS; i++)
+    {
+        Model.Pid.CommandLimit[i] = RobotSimTable.Joints[i].Gains.MaxRate * TEST_DT;
+    }
+    Model.Mode = ROBOT_SIM_MODE_VELOCITY;
+
+    for (t = 0; t < TEST_TICKS; t++)
+    {
+        RobotSimKinSetJoints(&Kin, Model.Position);
+        RobotSimVelSolve(&Vel, &Kin);
+
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Increment[i] = Vel.Rate[i] * TEST_DT;
+            Before[i]    = Model.Position[i];
+        }
+
+        RobotSimModelSetRate(&Model, Increment);
+        RobotSimModelControl(&Model);
+        RobotSimModelPhysics(&Model);
+
+        /*
+        ** Ratio of commanded to requested increment, the same on every joint
+        ** that moves when the direction is kept
+        */
+        Ratio = -1.0f;
+        for (i = 0; i < NUM_JOINTS; i++)
+        {
+            Limit = Model.Pid.CommandLimit[i];
+            Step  = fabsf(Model.Position[i] - Before[i]);
+            if (Step - Limit > WorstOver)
+            {
+                WorstOver = Step - Limit;
+            }
+            if (fabsf(Increment[i]) > Limit)
+            {
+                Saturated++;
+            }
+            if (fabsf(Increment[i]) > 1.0e-9f)
+            {
+                if (Ratio < 0.0f)
+                {
+                    Ratio = Model.Command[i] / Increment[i];
+                }
+                else if (fabsf(Model.Command[i] / Increment[i] - Ratio) > WorstBend)
+                {
+                    WorstBend = fabsf(Model.Command[i] / Increment[i] - Ratio);
+                }
+            }
+        }
+    }
+
+    printf("robot_sim_vel_test: %d saturated joint requests, worst excess %g rad, worst bend %g\n", Saturated,
+           (double)WorstOver, (double)WorstBend);
+
+    /*
+    ** The twist must actually be out of range, or the test proves nothing
+    */
+    if (Saturated == 0 || WorstOver > 1.0e-6f || WorstBend > 1.0e-4f)
+    {
+        printf("robot_sim_vel_test: FAILED\n");
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}